@@ -1,65 +1,160 @@
 package com.matter.bridge.app
 
+import android.util.SparseIntArray
+import java.nio.ByteBuffer
+
 sealed class BridgedDevice(
     var name: String,
     val endpoint: Int,
     val type: DeviceType,
     var isReachable: Boolean = true,
-    val isBridgedNode: Boolean = false  // True if has BRIDGED_NODE device type
+    val isBridgedNode: Boolean = false,  // True if has BRIDGED_NODE device type
+    val parentEndpointId: Int = 1        // Aggregator, or the composed device this one is part of
 ) {
+    // Direct buffer shared with the native attribute store, attached on first update. Re-fetched with the offsets
+    // once native reports it detached, e.g. after the endpoint was removed and added again.
+    private var attributeBuffer: ByteBuffer? = null
+    private val attributeOffsets = SparseIntArray()
+
+    private companion object {
+        const val SEQUENCE_SIZE = 4 // write sequence in front of each slot, see BridgeApp.getAttributeBuffer
+        const val MAX_PUBLISH_RETRIES = 3
+    }
+
+    /**
+     * Writes a value in place into the shared native attribute region and publishes it.
+     * Returns false if the attribute is not stored natively, so callers can fall back to updateClusterAttribute.
+     */
+    protected fun writeShared(
+        bridgeApp: BridgeApp,
+        clusterId: Int,
+        attributeId: Int,
+        write: (ByteBuffer, Int) -> Unit
+    ): Boolean = synchronized(this) {
+        repeat(2) {
+            val buffer = sharedBuffer(bridgeApp) ?: return false
+            val offset = sharedOffset(bridgeApp, clusterId, attributeId)
+            if (offset < 0) return false
+
+            // Seqlock: native only publishes a copy taken while the sequence in front of the slot is even and unchanged
+            val sequenceOffset = offset - SEQUENCE_SIZE
+            val sequence = buffer.getInt(sequenceOffset)
+            buffer.putInt(sequenceOffset, sequence + 1)
+            write(buffer, offset)
+            buffer.putInt(sequenceOffset, sequence + 2)
+
+            var result = bridgeApp.markAttributeDirty(endpoint, buffer, clusterId, attributeId)
+            var retries = MAX_PUBLISH_RETRIES
+            while (result == BridgeApp.MARK_DIRTY_RETRY && retries-- > 0) {
+                result = bridgeApp.markAttributeDirty(endpoint, buffer, clusterId, attributeId)
+            }
+            if (result != BridgeApp.MARK_DIRTY_DETACHED) return result == BridgeApp.MARK_DIRTY_OK
+
+            // Detached, e.g. the endpoint was removed and added again: attach a fresh buffer and retry once
+            attributeBuffer = null
+            attributeOffsets.clear()
+        }
+        false
+    }
+
+    // Reads a value from the shared native attribute region; null if the attribute is not stored natively. Values set
+    // natively after the buffer was attached are not in it.
+    protected fun <T> readShared(bridgeApp: BridgeApp, clusterId: Int, attributeId: Int, read: (ByteBuffer, Int) -> T): T? =
+        synchronized(this) {
+            val buffer = sharedBuffer(bridgeApp) ?: return null
+            val offset = sharedOffset(bridgeApp, clusterId, attributeId)
+            if (offset < 0) null else read(buffer, offset)
+        }
+
+    private fun sharedBuffer(bridgeApp: BridgeApp): ByteBuffer? =
+        attributeBuffer ?: bridgeApp.getAttributeBuffer(endpoint)?.also { attributeBuffer = it }
+
+    private fun sharedOffset(bridgeApp: BridgeApp, clusterId: Int, attributeId: Int): Int {
+        val key = (clusterId shl 16) or (attributeId and 0xFFFF)
+        var offset = attributeOffsets.get(key, -1)
+        if (offset < 0) {
+            offset = bridgeApp.getAttributeOffset(endpoint, clusterId, attributeId)
+            if (offset >= 0) attributeOffsets.put(key, offset)
+        }
+        return offset
+    }
+
+    /**
+     * Picks up the values the native store already holds, e.g. for a device the native layer restored from the
+     * registry snapshot, so the model does not start from defaults.
+     */
+    open fun loadState(bridgeApp: BridgeApp) {}
+
     // Light device with OnOff cluster
-    class Light(name: String, endpoint: Int, var isOn: Boolean = false, isBridgedNode: Boolean = true) : 
-        BridgedDevice(name, endpoint, DeviceType.LIGHT, isReachable = true, isBridgedNode = isBridgedNode) {
+    class Light(name: String, endpoint: Int, var isOn: Boolean = false, isBridgedNode: Boolean = true, parentEndpointId: Int = 1) :
+        BridgedDevice(name, endpoint, DeviceType.LIGHT, isReachable = true, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId) {
+
+        override fun loadState(bridgeApp: BridgeApp) {
+            readShared(bridgeApp, MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.ON_OFF) { buffer, offset ->
+                buffer.get(offset) != 0.toByte()
+            }?.let { isOn = it }
+        }
         
         fun setOnOff(bridgeApp: BridgeApp, value: Boolean) {
             isOn = value
-            // Convert boolean to 1-byte array (0 or 1)
-            val bytes = byteArrayOf(if (value) 1.toByte() else 0.toByte())
-            bridgeApp.updateClusterAttribute(
+            if (writeShared(bridgeApp, MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.ON_OFF) { buffer, offset ->
+                    buffer.put(offset, if (value) 1.toByte() else 0.toByte())
+                }) return
+            BridgeApp.updateBool(
                 endpoint,
                 MatterConstants.OnOff.CLUSTER_ID,
                 MatterConstants.OnOff.Attributes.ON_OFF,
-                bytes
+                value
             )
         }
     }
         
     // Temperature Sensor with TemperatureMeasurement cluster
-    class TemperatureSensor(name: String, endpoint: Int, var temperature: Int = 0, isBridgedNode: Boolean = true) :
-        BridgedDevice(name, endpoint, DeviceType.TEMP_SENSOR, isReachable = true, isBridgedNode = isBridgedNode) {
+    class TemperatureSensor(name: String, endpoint: Int, var temperature: Int = 0, isBridgedNode: Boolean = true, parentEndpointId: Int = 1) :
+        BridgedDevice(name, endpoint, DeviceType.TEMP_SENSOR, isReachable = true, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId) {
+
+        override fun loadState(bridgeApp: BridgeApp) {
+            readShared(bridgeApp, MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MEASURED_VALUE) { buffer, offset ->
+                buffer.getShort(offset).toInt()
+            }?.let { temperature = it }
+        }
         
         fun setTemperature(bridgeApp: BridgeApp, value: Int) {
             temperature = value
-            // Convert int to 2-byte array (int16) - Little Endian
-            val bytes = ByteArray(2)
-            bytes[0] = (value and 0xFF).toByte()
-            bytes[1] = ((value shr 8) and 0xFF).toByte()
-            
-            bridgeApp.updateClusterAttribute(
+            if (writeShared(bridgeApp, MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MEASURED_VALUE) { buffer, offset ->
+                    buffer.putShort(offset, value.toShort())
+                }) return
+            // Stored as int16, little-endian
+            BridgeApp.updateInt(
                 endpoint,
                 MatterConstants.TemperatureMeasurement.CLUSTER_ID,
                 MatterConstants.TemperatureMeasurement.Attributes.MEASURED_VALUE,
-                bytes
+                value.toLong()
             )
         }
     }
     
     // Humidity Sensor with RelativeHumidityMeasurement cluster
-    class HumiditySensor(name: String, endpoint: Int, var humidity: Int = 0, isBridgedNode: Boolean = true) :
-        BridgedDevice(name, endpoint, DeviceType.HUMIDITY_SENSOR, isReachable = true, isBridgedNode = isBridgedNode) {
+    class HumiditySensor(name: String, endpoint: Int, var humidity: Int = 0, isBridgedNode: Boolean = true, parentEndpointId: Int = 1) :
+        BridgedDevice(name, endpoint, DeviceType.HUMIDITY_SENSOR, isReachable = true, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId) {
+
+        override fun loadState(bridgeApp: BridgeApp) {
+            readShared(bridgeApp, MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MEASURED_VALUE) { buffer, offset ->
+                buffer.getShort(offset).toInt() and 0xFFFF
+            }?.let { humidity = it }
+        }
         
         fun setHumidity(bridgeApp: BridgeApp, value: Int) {
             humidity = value
-            // Convert int to 2-byte array (uint16) - Little Endian
-            val bytes = ByteArray(2)
-            bytes[0] = (value and 0xFF).toByte()
-            bytes[1] = ((value shr 8) and 0xFF).toByte()
-            
-            bridgeApp.updateClusterAttribute(
+            if (writeShared(bridgeApp, MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MEASURED_VALUE) { buffer, offset ->
+                    buffer.putShort(offset, value.toShort())
+                }) return
+            // Stored as uint16, little-endian
+            BridgeApp.updateInt(
                 endpoint,
                 MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID,
                 MatterConstants.RelativeHumidityMeasurement.Attributes.MEASURED_VALUE,
-                bytes
+                value.toLong()
             )
         }
     }
@@ -69,19 +164,27 @@ sealed class BridgedDevice(
         name: String, 
         endpoint: Int,
         var batteryChargeLevel: Int = 0,
-        isBridgedNode: Boolean = true
-    ) : BridgedDevice(name, endpoint, DeviceType.COMPOSED_DEVICE, isReachable = true, isBridgedNode = isBridgedNode) {
+        isBridgedNode: Boolean = true,
+        parentEndpointId: Int = 1
+    ) : BridgedDevice(name, endpoint, DeviceType.COMPOSED_DEVICE, isReachable = true, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId) {
+
+        override fun loadState(bridgeApp: BridgeApp) {
+            readShared(bridgeApp, MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.BAT_CHARGE_LEVEL) { buffer, offset ->
+                buffer.get(offset).toInt() and 0xFF
+            }?.let { batteryChargeLevel = it }
+        }
         
         fun setBatteryChargeLevel(bridgeApp: BridgeApp, value: Int) {
             batteryChargeLevel = value
-            // Convert to 1-byte enum
-            val bytes = byteArrayOf(value.toByte())
-            
-            bridgeApp.updateClusterAttribute(
+            if (writeShared(bridgeApp, MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.BAT_CHARGE_LEVEL) { buffer, offset ->
+                    buffer.put(offset, value.toByte())
+                }) return
+            // Stored as a 1-byte enum
+            BridgeApp.updateInt(
                 endpoint,
                 MatterConstants.PowerSource.CLUSTER_ID,
                 MatterConstants.PowerSource.Attributes.BAT_CHARGE_LEVEL,
-                bytes
+                value.toLong()
             )
         }
     }
@@ -91,8 +194,9 @@ sealed class BridgedDevice(
         name: String, 
         endpoint: Int, 
         val clusterIds: List<Int>,
-        isBridgedNode: Boolean = false
-    ) : BridgedDevice(name, endpoint, DeviceType.GENERIC, isReachable = true, isBridgedNode = isBridgedNode) {
+        isBridgedNode: Boolean = false,
+        parentEndpointId: Int = 1
+    ) : BridgedDevice(name, endpoint, DeviceType.GENERIC, isReachable = true, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId) {
         
         // Store attributes as generic objects to support different types
         private val attributes = mutableMapOf<Int, MutableMap<Int, Any>>()
@@ -1,131 +1,226 @@
 package com.matter.bridge.app
 
+import android.os.SystemClock
+import java.util.concurrent.ConcurrentHashMap
+
 object DeviceFactory {
     
     private var bridgeApp: BridgeApp? = null
+
+    // Native template IDs of the device definitions registered so far, by factory kind
+    private val templates = ConcurrentHashMap<String, Int>()
+
+    // Devices created inside batch { } on the calling thread, added with a single addBridgedDevices call at its end
+    private val pendingSpecs = ThreadLocal<MutableList<DeviceSpec>?>()
+
+    // Start of each batch by request ID, see batchElapsedMicros
+    private val batchStarts = ConcurrentHashMap<Int, Long>()
+
+    /**
+     * Cold-start comparison: when false, batch { } adds its devices with one native call (and one Matter-thread task)
+     * each, as before addBridgedDevices existed, followed by an empty addBridgedDevices call whose result marks the
+     * point where all of them are online. Compare batchElapsedMicros of both modes.
+     */
+    @Volatile var bulkAdd = true
     
     fun initialize(app: BridgeApp) {
         bridgeApp = app
+        templates.clear()
+    }
+
+    /**
+     * Runs [block] and adds all devices it creates with one native call, so their endpoints are registered together.
+     * Returns the request ID reported to BridgeAppCallback.onBridgedDevicesAdded, or -1 if nothing was added.
+     */
+    fun batch(block: () -> Unit): Int {
+        val start = SystemClock.elapsedRealtimeNanos()
+        val specs = mutableListOf<DeviceSpec>()
+        val outer = pendingSpecs.get()
+        pendingSpecs.set(specs)
+        try {
+            block()
+        } finally {
+            pendingSpecs.set(outer)
+        }
+        val app = bridgeApp ?: return -1
+        if (specs.isEmpty()) {
+            return -1
+        }
+        if (!bulkAdd) {
+            specs.forEach { app.addBridgedDeviceFromTemplate(it.templateId, it.endpoint, it.parentEndpointId, it.name) }
+        }
+        val requestId = app.addBridgedDevices(if (bulkAdd) specs.toTypedArray() else emptyArray())
+        if (requestId >= 0) {
+            batchStarts[requestId] = start
+        }
+        return requestId
+    }
+
+    /**
+     * Time from the start of the batch { } that returned [requestId] until its devices were online, for
+     * BridgeAppCallback.onBridgedDevicesAdded; -1 for requests not started by batch.
+     */
+    fun batchElapsedMicros(requestId: Int): Long {
+        val start = batchStarts.remove(requestId) ?: return -1
+        return (SystemClock.elapsedRealtimeNanos() - start) / 1000
+    }
+
+    /**
+     * Kotlin model of a device the native layer re-created from the registry snapshot; its endpoint already exists,
+     * so nothing is registered again. The model starts from the values the native store restored.
+     */
+    fun restoreDevice(name: String, endpoint: Int, parentEndpointId: Int, deviceTypes: IntArray, clusters: IntArray): BridgedDevice {
+        val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
+        val device = when {
+            deviceTypes.contains(MatterConstants.DeviceType.ON_OFF_LIGHT) -> BridgedDevice.Light(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
+            deviceTypes.contains(MatterConstants.DeviceType.TEMP_SENSOR) -> BridgedDevice.TemperatureSensor(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
+            deviceTypes.contains(MatterConstants.DeviceType.HUMIDITY_SENSOR) -> BridgedDevice.HumiditySensor(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
+            deviceTypes.contains(MatterConstants.DeviceType.POWER_SOURCE) -> BridgedDevice.Composed(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
+            else -> BridgedDevice.Generic(name, endpoint, clusters.toList(), isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
+        }
+        bridgeApp?.let { device.loadState(it) }
+        return device
     }
+
+    // Adds a device from its registered template; the attribute definitions are only built and sent the first time
+    private fun addDevice(kind: String, endpoint: Int, parentEndpointId: Int, name: String, clusters: IntArray,
+                          deviceTypes: IntArray, attributes: () -> Array<ClusterAttribute>) {
+        val app = bridgeApp ?: return
+        val templateId = templates[kind] ?: app.registerDeviceTemplate(clusters, attributes(), deviceTypes).also {
+            if (it >= 0) templates[kind] = it
+        }
+        if (templateId < 0) {
+            return
+        }
+        val specs = pendingSpecs.get()
+        if (specs != null) {
+            specs.add(DeviceSpec.fromTemplate(templateId, endpoint, parentEndpointId, name))
+        } else {
+            app.addBridgedDeviceFromTemplate(templateId, endpoint, parentEndpointId, name)
+        }
+    }
+
+    // Little-endian 16-bit encoding for constant attribute values
+    private fun int16(value: Int) = byteArrayOf((value and 0xFF).toByte(), ((value shr 8) and 0xFF).toByte())
     
     fun createLight(name: String, endpoint: Int, parentEndpointId: Int = 1): BridgedDevice.Light {
         val clusters = intArrayOf(MatterConstants.OnOff.CLUSTER_ID)
         val deviceTypes = intArrayOf(MatterConstants.DeviceType.ON_OFF_LIGHT, MatterConstants.DeviceType.BRIDGED_NODE)
         
-        val attributes = arrayOf(
-            ClusterAttribute(MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.ON_OFF, MatterConstants.AttributeType.BOOLEAN, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.WRITABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
-        )
-        
-        bridgeApp?.addBridgedDevice(endpoint, parentEndpointId, name, clusters, attributes, deviceTypes)
+        addDevice("light", endpoint, parentEndpointId, name, clusters, deviceTypes) {
+            arrayOf(
+                ClusterAttribute(MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.ON_OFF, MatterConstants.AttributeType.BOOLEAN, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.WRITABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute.constant(MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(4))
+            )
+        }
         
         // Check if device has BRIDGED_NODE device type
         val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
-        return BridgedDevice.Light(name, endpoint, isBridgedNode = isBridgedNode)
+        return BridgedDevice.Light(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
     }
     
     fun createTempSensor(name: String, endpoint: Int, parentEndpointId: Int = 1): BridgedDevice.TemperatureSensor {
         val clusters = intArrayOf(MatterConstants.TemperatureMeasurement.CLUSTER_ID)
         val deviceTypes = intArrayOf(MatterConstants.DeviceType.TEMP_SENSOR, MatterConstants.DeviceType.BRIDGED_NODE)
         
-        val attributes = arrayOf(
-            ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MIN_MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MAX_MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
-        )
-        
-        bridgeApp?.addBridgedDevice(endpoint, parentEndpointId, name, clusters, attributes, deviceTypes)
+        addDevice("temp-sensor", endpoint, parentEndpointId, name, clusters, deviceTypes) {
+            arrayOf(
+                ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute.constant(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MIN_MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(-1000)),
+                ClusterAttribute.constant(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MAX_MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(5000)),
+                ClusterAttribute.constant(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(4))
+            )
+        }
         
         // Check if device has BRIDGED_NODE device type
         val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
-        return BridgedDevice.TemperatureSensor(name, endpoint, isBridgedNode = isBridgedNode)
+        return BridgedDevice.TemperatureSensor(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
     }
 
     fun createComposedTempSensor(name: String, endpoint: Int, parentEndpointId: Int = 1): BridgedDevice.TemperatureSensor {
         val clusters = intArrayOf(MatterConstants.TemperatureMeasurement.CLUSTER_ID)
         val deviceTypes = intArrayOf(MatterConstants.DeviceType.TEMP_SENSOR)
 
-        val attributes = arrayOf(
-            ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MIN_MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MAX_MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
-        )
-
-        bridgeApp?.addBridgedDevice(endpoint, parentEndpointId, name, clusters, attributes, deviceTypes)
+        addDevice("composed-temp-sensor", endpoint, parentEndpointId, name, clusters, deviceTypes) {
+            arrayOf(
+                ClusterAttribute(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute.constant(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MIN_MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(-1000)),
+                ClusterAttribute.constant(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.MAX_MEASURED_VALUE, MatterConstants.AttributeType.INT16S, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(5000)),
+                ClusterAttribute.constant(MatterConstants.TemperatureMeasurement.CLUSTER_ID, MatterConstants.TemperatureMeasurement.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(4))
+            )
+        }
         
         // Check if device has BRIDGED_NODE device type
         val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
-        return BridgedDevice.TemperatureSensor(name, endpoint, isBridgedNode = isBridgedNode)
+        return BridgedDevice.TemperatureSensor(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
     }
     
     fun createHumiditySensor(name: String, endpoint: Int, parentEndpointId: Int = 1): BridgedDevice.HumiditySensor {
         val clusters = intArrayOf(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID)
         val deviceTypes = intArrayOf(MatterConstants.DeviceType.HUMIDITY_SENSOR, MatterConstants.DeviceType.BRIDGED_NODE)
         
-        val attributes = arrayOf(
-            ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MIN_MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MAX_MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
-        )
-        
-        bridgeApp?.addBridgedDevice(endpoint, parentEndpointId, name, clusters, attributes, deviceTypes)
+        addDevice("humidity-sensor", endpoint, parentEndpointId, name, clusters, deviceTypes) {
+            arrayOf(
+                ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute.constant(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MIN_MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(0)),
+                ClusterAttribute.constant(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MAX_MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(10000)),
+                ClusterAttribute.constant(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(4))
+            )
+        }
         
         // Check if device has BRIDGED_NODE device type
         val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
-        return BridgedDevice.HumiditySensor(name, endpoint, isBridgedNode = isBridgedNode)
+        return BridgedDevice.HumiditySensor(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
     }
 
     fun createComposedHumiditySensor(name: String, endpoint: Int, parentEndpointId: Int = 1): BridgedDevice.HumiditySensor {
         val clusters = intArrayOf(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID)
         val deviceTypes = intArrayOf(MatterConstants.DeviceType.HUMIDITY_SENSOR)  // No BRIDGED_NODE
 
-        val attributes = arrayOf(
-            ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MIN_MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MAX_MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
-        )
-
-        bridgeApp?.addBridgedDevice(endpoint, parentEndpointId, name, clusters, attributes, deviceTypes)
+        addDevice("composed-humidity-sensor", endpoint, parentEndpointId, name, clusters, deviceTypes) {
+            arrayOf(
+                ClusterAttribute(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute.constant(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MIN_MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(0)),
+                ClusterAttribute.constant(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.MAX_MEASURED_VALUE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(10000)),
+                ClusterAttribute.constant(MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID, MatterConstants.RelativeHumidityMeasurement.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(4))
+            )
+        }
         
         // Check if device has BRIDGED_NODE device type
         val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
-        return BridgedDevice.HumiditySensor(name, endpoint, isBridgedNode = isBridgedNode)
+        return BridgedDevice.HumiditySensor(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
     }
     
     fun createDoorLock(name: String, endpoint: Int, parentEndpointId: Int = 1): BridgedDevice.Generic {
         val clusters = intArrayOf(MatterConstants.DoorLock.CLUSTER_ID)
         val deviceTypes = intArrayOf(MatterConstants.DeviceType.BRIDGED_NODE)
         
-        val attributes = arrayOf(
-            ClusterAttribute(MatterConstants.DoorLock.CLUSTER_ID, MatterConstants.DoorLock.Attributes.LOCK_STATE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.DoorLock.CLUSTER_ID, MatterConstants.DoorLock.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
-        )
-        
-        bridgeApp?.addBridgedDevice(endpoint, parentEndpointId, name, clusters, attributes, deviceTypes)
+        addDevice("door-lock", endpoint, parentEndpointId, name, clusters, deviceTypes) {
+            arrayOf(
+                ClusterAttribute(MatterConstants.DoorLock.CLUSTER_ID, MatterConstants.DoorLock.Attributes.LOCK_STATE, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute(MatterConstants.DoorLock.CLUSTER_ID, MatterConstants.DoorLock.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
+            )
+        }
         
         // Check if device has BRIDGED_NODE device type
         val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
-        return BridgedDevice.Generic(name, endpoint, clusters.toList(), isBridgedNode = isBridgedNode)
+        return BridgedDevice.Generic(name, endpoint, clusters.toList(), isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
     }
     
     fun createGenericOnOffDevice(name: String, endpoint: Int, parentEndpointId: Int = 1): BridgedDevice.Generic {
         val clusters = intArrayOf(MatterConstants.OnOff.CLUSTER_ID)
         val deviceTypes = intArrayOf(MatterConstants.DeviceType.ON_OFF_LIGHT, MatterConstants.DeviceType.BRIDGED_NODE)
         
-        val attributes = arrayOf(
-            ClusterAttribute(MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.ON_OFF, MatterConstants.AttributeType.BOOLEAN, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.WRITABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
-        )
-        
-        bridgeApp?.addBridgedDevice(endpoint, parentEndpointId, name, clusters, attributes, deviceTypes)
+        addDevice("generic-on-off", endpoint, parentEndpointId, name, clusters, deviceTypes) {
+            arrayOf(
+                ClusterAttribute(MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.ON_OFF, MatterConstants.AttributeType.BOOLEAN, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.WRITABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute.constant(MatterConstants.OnOff.CLUSTER_ID, MatterConstants.OnOff.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE, int16(4))
+            )
+        }
         
         // Check if device has BRIDGED_NODE device type
         val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
-        return BridgedDevice.Generic(name, endpoint, clusters.toList(), isBridgedNode = isBridgedNode)
+        return BridgedDevice.Generic(name, endpoint, clusters.toList(), isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
     }
     
     /**
@@ -140,18 +235,18 @@ object DeviceFactory {
             MatterConstants.DeviceType.POWER_SOURCE
         )
         
-        val attributes = arrayOf(
-            ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.BAT_CHARGE_LEVEL, MatterConstants.AttributeType.ENUM8, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.ORDER, MatterConstants.AttributeType.INT8U, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.STATUS, MatterConstants.AttributeType.ENUM8, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.DESCRIPTION, MatterConstants.AttributeType.CHAR_STRING, 32, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
-            ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
-        )
-        
-        bridgeApp?.addBridgedDevice(endpoint, parentEndpointId, name, clusters, attributes, deviceTypes)
+        addDevice("composed-device", endpoint, parentEndpointId, name, clusters, deviceTypes) {
+            arrayOf(
+                ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.BAT_CHARGE_LEVEL, MatterConstants.AttributeType.ENUM8, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.ORDER, MatterConstants.AttributeType.INT8U, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.STATUS, MatterConstants.AttributeType.ENUM8, 1, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.DESCRIPTION, MatterConstants.AttributeType.CHAR_STRING, 32, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE),
+                ClusterAttribute(MatterConstants.PowerSource.CLUSTER_ID, MatterConstants.PowerSource.Attributes.CLUSTER_REVISION, MatterConstants.AttributeType.INT16U, 2, MatterConstants.AttributeMask.READABLE or MatterConstants.AttributeMask.EXTERNAL_STORAGE)
+            )
+        }
         
         // Check if device has BRIDGED_NODE device type
         val isBridgedNode = deviceTypes.contains(MatterConstants.DeviceType.BRIDGED_NODE)
-        return BridgedDevice.Composed(name, endpoint, isBridgedNode = isBridgedNode)
+        return BridgedDevice.Composed(name, endpoint, isBridgedNode = isBridgedNode, parentEndpointId = parentEndpointId)
     }
 }
@@ -12,6 +12,8 @@ import androidx.recyclerview.widget.LinearLayoutManager
 import androidx.recyclerview.widget.RecyclerView
 import com.google.android.material.floatingactionbutton.FloatingActionButton
 import com.google.android.material.snackbar.Snackbar
+import java.io.File
+import java.nio.ByteBuffer
 import timber.log.Timber
 
 class MainActivity : AppCompatActivity() {
@@ -81,6 +83,34 @@ class MainActivity : AppCompatActivity() {
                   override fun onEvent(event: Long) {
                       Timber.d("Event received: $event")
                   }
+
+                  override fun onBridgedDevicesAdded(requestId: Int, endpoints: IntArray, elapsedMicros: Long) {
+                      val failed = endpoints.count { it < 0 }
+                      Timber.i("Bridged devices online: ${endpoints.size - failed}/${endpoints.size} after ${elapsedMicros / 1000} ms (request $requestId)")
+                      val batchMicros = DeviceFactory.batchElapsedMicros(requestId)
+                      if (batchMicros >= 0) {
+                          Timber.i("Cold start: batch $requestId online ${batchMicros / 1000} ms after it started (bulkAdd=${DeviceFactory.bulkAdd})")
+                      }
+                  }
+
+                  override fun onBridgedDevicesRestored(
+                      endpoints: IntArray,
+                      parentEndpointIds: IntArray,
+                      names: Array<String>,
+                      deviceTypeIds: Array<IntArray>,
+                      clusterIds: Array<IntArray>,
+                      elapsedMicros: Long
+                  ) {
+                      Timber.i("Restored ${endpoints.size} bridged devices from the registry snapshot in ${elapsedMicros / 1000} ms")
+                      val restored = endpoints.indices.map { i ->
+                          DeviceFactory.restoreDevice(names[i], endpoints[i], parentEndpointIds[i], deviceTypeIds[i], clusterIds[i])
+                      }
+                      runOnUiThread {
+                          devices.clear()
+                          devices.addAll(restored)
+                          deviceAdapter.notifyDataSetChanged()
+                      }
+                  }
                   
                   override fun onDeviceStateChanged(
                       endpoint: Int,
@@ -98,6 +128,25 @@ class MainActivity : AppCompatActivity() {
                           handleDeviceStateChange(endpoint, clusterId, attributeId, value)
                       }
                   }
+
+                  override fun onDeviceStateChangedBatch(
+                      endpoints: IntArray,
+                      clusterIds: IntArray,
+                      attributeIds: IntArray,
+                      values: ByteArray,
+                      offsets: IntArray
+                  ) {
+                      Timber.i("Device state changed - ${endpoints.size} attributes")
+                      // One UI post for the whole batch
+                      runOnUiThread {
+                          for (i in endpoints.indices) {
+                              val value = values.copyOfRange(offsets[i], offsets[i + 1])
+                              if (value.isNotEmpty()) {
+                                  handleDeviceStateChange(endpoints[i], clusterIds[i], attributeIds[i], value)
+                              }
+                          }
+                      }
+                  }
                   
                   override fun onClusterAttributeRead(
                       endpoint: Int,
@@ -107,6 +156,15 @@ class MainActivity : AppCompatActivity() {
                   ): ByteArray? {
                       return handleClusterAttributeRead(endpoint, clusterId, attributeId, maxReadLength)
                   }
+
+                  override fun onClusterAttributeRead(
+                      endpoint: Int,
+                      clusterId: Int,
+                      attributeId: Int,
+                      out: ByteBuffer
+                  ): Int {
+                      return handleClusterAttributeRead(endpoint, clusterId, attributeId, out)
+                  }
                   
                   override fun onClusterAttributeWrite(
                       endpoint: Int,
@@ -126,6 +184,9 @@ class MainActivity : AppCompatActivity() {
                   }
               })
               
+              // With a registry snapshot the devices are re-created natively at postServerInit
+              val restoring = app.setRegistrySnapshotPath(registrySnapshotFile().absolutePath)
+
               Timber.d("Step 2: Calling preServerInit...")
               app.preServerInit()
               
@@ -133,7 +194,11 @@ class MainActivity : AppCompatActivity() {
               // where read requests come in before devices are populated
               bridgeApp = app
               bridgeAppInstance = app
-              initializeDevices()
+              if (restoring) {
+                  Timber.d("Registry snapshot found, devices are restored at postServerInit")
+              } else {
+                  initializeDevices()
+              }
               
               // Update UI on main thread
               runOnUiThread {
@@ -292,6 +357,7 @@ class MainActivity : AppCompatActivity() {
       // Clear all devices
       devices.clear()
       deviceAdapter?.notifyDataSetChanged()
+      registrySnapshotFile().delete()
       
       // On Android, factory reset requires clearing persistent storage and restarting
       // This typically involves:
@@ -319,6 +385,8 @@ class MainActivity : AppCompatActivity() {
     startActivity(intent)
   }
 
+  private fun registrySnapshotFile() = File(filesDir, "bridge-registry.bin")
+
   private fun initializeDevices() {
     // Devices are now initialized from Kotlin using ServerInitializer
     // This replaces the hardcoded device initialization that was in C++ BridgeApp-JNI.cpp
@@ -512,6 +580,50 @@ class MainActivity : AppCompatActivity() {
       }
   }
 
+  /**
+   * Direct buffer variant of handleClusterAttributeRead: frequently read measured values are written straight
+   * into the native read buffer, everything else goes through the ByteArray path.
+   * Returns the number of bytes written or -1 if not handled.
+   */
+  private fun handleClusterAttributeRead(
+      endpoint: Int,
+      clusterId: Int,
+      attributeId: Int,
+      out: ByteBuffer
+  ): Int {
+      // Not created yet (startup), or just removed
+      val device = devices.find { it.endpoint == endpoint } ?: return BridgeAppCallback.READ_UNAVAILABLE
+
+      when {
+          device is BridgedDevice.Light &&
+              clusterId == MatterConstants.OnOff.CLUSTER_ID &&
+              attributeId == MatterConstants.OnOff.Attributes.ON_OFF -> {
+              out.put(if (device.isOn) 1.toByte() else 0.toByte())
+              return 1
+          }
+          device is BridgedDevice.TemperatureSensor &&
+              clusterId == MatterConstants.TemperatureMeasurement.CLUSTER_ID &&
+              attributeId == MatterConstants.TemperatureMeasurement.Attributes.MEASURED_VALUE -> {
+              out.putShort(device.temperature.toShort())
+              return 2
+          }
+          device is BridgedDevice.HumiditySensor &&
+              clusterId == MatterConstants.RelativeHumidityMeasurement.CLUSTER_ID &&
+              attributeId == MatterConstants.RelativeHumidityMeasurement.Attributes.MEASURED_VALUE -> {
+              out.putShort(device.humidity.toShort())
+              return 2
+          }
+      }
+
+      val value = handleClusterAttributeRead(endpoint, clusterId, attributeId, out.limit())
+          ?: return BridgeAppCallback.READ_UNHANDLED
+      if (value.size > out.remaining()) {
+          return BridgeAppCallback.READ_TOO_LARGE
+      }
+      out.put(value)
+      return value.size
+  }
+
   /**
    * Handle cluster attribute write requests from Matter stack.
    * Returns true if write was handled, false otherwise.
@@ -576,21 +688,23 @@ class MainActivity : AppCompatActivity() {
       commandId: Int
   ): Boolean {
       val device = devices.find { it.endpoint == endpoint } ?: return false
+      val app = bridgeApp ?: return false
       
+      // Push the new state through setOnOff: native keeps serving reads from its store after the command
       if (clusterId == MatterConstants.OnOff.CLUSTER_ID && device is BridgedDevice.Light) {
           when (commandId) {
               MatterConstants.OnOff.Commands.OFF -> {
-                  device.isOn = false
+                  device.setOnOff(app, false)
                   runOnUiThread { deviceAdapter.notifyDataSetChanged() }
                   return true
               }
               MatterConstants.OnOff.Commands.ON -> {
-                  device.isOn = true
+                  device.setOnOff(app, true)
                   runOnUiThread { deviceAdapter.notifyDataSetChanged() }
                   return true
               }
               MatterConstants.OnOff.Commands.TOGGLE -> {
-                  device.isOn = !device.isOn
+                  device.setOnOff(app, !device.isOn)
                   runOnUiThread { deviceAdapter.notifyDataSetChanged() }
                   return true
               }
@@ -627,6 +741,12 @@ class MainActivity : AppCompatActivity() {
       }
   }
 
+  override fun onStop() {
+    super.onStop()
+    // Persist the latest values and DataVersions in case the process is not coming back
+    bridgeApp?.let { app -> Thread { app.saveRegistrySnapshot() }.start() }
+  }
+
   override fun onDestroy() {
     super.onDestroy()
     Timber.d("onDestroy()")
@@ -20,33 +20,36 @@ object ServerInitializer {
         Timber.d("ServerInitializer: Creating default devices")
         
         try {
-            // Create initial bridged devices
-            // Create lights (endpoints 2-3)
-            devices.add(DeviceFactory.createLight("Light 1", 2))
-            devices.add(DeviceFactory.createLight("Light 2", 3))
-            // Create Temperature/Humidity Sensor (endpoints 4-5)
-            devices.add(DeviceFactory.createTempSensor("Temp Sensor 1", endpoint = 4))
-            devices.add(DeviceFactory.createHumiditySensor("Humidity Sensor 1", endpoint = 5))
+            // All default devices are registered by one native call
+            DeviceFactory.batch {
+                // Create initial bridged devices
+                // Create lights (endpoints 2-3)
+                devices.add(DeviceFactory.createLight("Light 1", 2))
+                devices.add(DeviceFactory.createLight("Light 2", 3))
+                // Create Temperature/Humidity Sensor (endpoints 4-5)
+                devices.add(DeviceFactory.createTempSensor("Temp Sensor 1", endpoint = 4))
+                devices.add(DeviceFactory.createHumiditySensor("Humidity Sensor 1", endpoint = 5))
             
-            // Composed device example: Parent + Child
-            val parentDevice = DeviceFactory.createComposedDevice("Composed Device", endpoint = 10)
-            devices.add(parentDevice)
+                // Composed device example: Parent + Child
+                val parentDevice = DeviceFactory.createComposedDevice("Composed Device", endpoint = 10)
+                devices.add(parentDevice)
             
-            // Child sensor under composed device (endpoint 11 has parent 10)
-            val childTempSensor = DeviceFactory.createComposedTempSensor(
-                "Composed Temp Sensor",
-                endpoint = 11, 
-                parentEndpointId = 10
-            )
-            devices.add(childTempSensor)
+                // Child sensor under composed device (endpoint 11 has parent 10)
+                val childTempSensor = DeviceFactory.createComposedTempSensor(
+                    "Composed Temp Sensor",
+                    endpoint = 11, 
+                    parentEndpointId = 10
+                )
+                devices.add(childTempSensor)
             
-            // Child humidity sensor under composed device (endpoint 12 has parent 10)
-            val childHumiditySensor = DeviceFactory.createComposedHumiditySensor(
-                "Composed Humidity Sensor", 
-                endpoint = 12, 
-                parentEndpointId = 10
-            )
-            devices.add(childHumiditySensor)
+                // Child humidity sensor under composed device (endpoint 12 has parent 10)
+                val childHumiditySensor = DeviceFactory.createComposedHumiditySensor(
+                    "Composed Humidity Sensor", 
+                    endpoint = 12, 
+                    parentEndpointId = 10
+                )
+                devices.add(childHumiditySensor)
+            }
             
             devices.sortBy { it.endpoint }
             
@@ -64,8 +67,10 @@ object ServerInitializer {
         Timber.d("ServerInitializer: Creating minimal device set")
         
         try {
-            devices.add(DeviceFactory.createLight("Light 1", 2))
-            devices.add(DeviceFactory.createTempSensor("Temperature Sensor 1", 4))
+            DeviceFactory.batch {
+                devices.add(DeviceFactory.createLight("Light 1", 2))
+                devices.add(DeviceFactory.createTempSensor("Temperature Sensor 1", 4))
+            }
             
             devices.sortBy { it.endpoint }
             
@@ -0,0 +1,622 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "AttributeStore.h"
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+using namespace chip;
+
+AttributeStore AttributeStore::sInstance;
+
+namespace {
+
+// Every slot is preceded by the 32-bit write sequence of the Kotlin seqlock, see AttributeStore::GetSlot
+constexpr uint32_t kSequenceSize = sizeof(uint32_t);
+// Copies MarkDirty attempts while a write to the slot is in progress
+constexpr int kMaxCopyAttempts = 8;
+
+uint32_t LoadSequence(const uint8_t * slot)
+{
+    return __atomic_load_n(reinterpret_cast<const uint32_t *>(slot - kSequenceSize), __ATOMIC_ACQUIRE);
+}
+
+// Size of the ZCL length prefix for string attributes, 0 for fixed-size types.
+uint16_t LengthPrefixSize(EmberAfAttributeType type)
+{
+    switch (type)
+    {
+    case ZAP_TYPE(CHAR_STRING):
+    case ZAP_TYPE(OCTET_STRING):
+        return 1;
+    case ZAP_TYPE(LONG_CHAR_STRING):
+    case ZAP_TYPE(LONG_OCTET_STRING):
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+// Number of bytes a ZCL encoded string occupies in a buffer, including its prefix.
+uint16_t EncodedStringSize(uint16_t prefixSize, const uint8_t * value)
+{
+    if (prefixSize == 1)
+    {
+        // 0xFF is the null string
+        return static_cast<uint16_t>(1 + ((value[0] == 0xFF) ? 0 : value[0]));
+    }
+    uint16_t length = Encoding::LittleEndian::Get16(value);
+    return static_cast<uint16_t>(2 + ((length == 0xFFFF) ? 0 : length));
+}
+
+// Natural alignment of a fixed-size slot, capped at 8 bytes.
+uint32_t SlotAlignment(uint16_t prefixSize, uint16_t capacity)
+{
+    if (prefixSize > 0 || capacity <= 1)
+    {
+        return 1;
+    }
+    if (capacity <= 2)
+    {
+        return 2;
+    }
+    return (capacity <= 4) ? 4 : 8;
+}
+
+bool IsSignedIntegerType(EmberAfAttributeType type)
+{
+    switch (type)
+    {
+    case ZAP_TYPE(INT8S):
+    case ZAP_TYPE(INT16S):
+    case ZAP_TYPE(INT24S):
+    case ZAP_TYPE(INT32S):
+    case ZAP_TYPE(INT40S):
+    case ZAP_TYPE(INT48S):
+    case ZAP_TYPE(INT56S):
+    case ZAP_TYPE(INT64S):
+    case ZAP_TYPE(TEMPERATURE):
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+uint16_t AttributeStore::EncodedValueSize(EmberAfAttributeType type, uint16_t size, const uint8_t * value)
+{
+    uint16_t prefixSize = LengthPrefixSize(type);
+    VerifyOrReturnValue(prefixSize > 0 && size >= prefixSize, size);
+    return std::min(EncodedStringSize(prefixSize, value), size);
+}
+
+std::unique_ptr<AttributeStore::EndpointValues> AttributeStore::BuildValues(EndpointId endpoint,
+                                                                          const std::vector<AttributeDesc> & attributes)
+{
+    auto values = std::make_unique<EndpointValues>();
+
+    uint32_t offset = 0;
+    for (const auto & desc : attributes)
+    {
+        Entry entry;
+        entry.clusterId   = desc.clusterId;
+        entry.attributeId = desc.attributeId;
+        entry.type        = desc.type;
+        entry.flags       = desc.flags;
+        entry.valid       = false;
+        entry.unsupported = false;
+        entry.publishedLength = 0;
+        entry.capacity    = static_cast<uint16_t>(desc.size + LengthPrefixSize(desc.type));
+        entry.length      = 0;
+
+        // Keeps the sequence word in front of the slot 4-byte aligned
+        uint32_t alignment = std::max<uint32_t>(SlotAlignment(LengthPrefixSize(desc.type), entry.capacity), kSequenceSize);
+        offset             = (offset + kSequenceSize + alignment - 1) & ~(alignment - 1);
+        entry.offset       = offset;
+        offset += entry.capacity;
+        values->entries.push_back(entry);
+    }
+
+    values->blockSize = offset;
+    values->local.reset(new uint8_t[offset > 0 ? offset : 1]());
+    values->block     = std::shared_ptr<uint8_t>(values->local.get(), [](uint8_t *) {});
+    values->published.reset(new uint8_t[offset > 0 ? offset : 1]());
+
+    // Seed registration defaults; constants are answered from here for the lifetime of the endpoint
+    uint16_t constantCount = 0;
+    for (size_t i = 0; i < attributes.size(); i++)
+    {
+        Entry & entry = values->entries[i];
+        if (attributes[i].defaultValue.empty())
+        {
+            // A constant without a value would never be readable
+            entry.flags = static_cast<uint8_t>(entry.flags & ~kFlag_Constant);
+            continue;
+        }
+        ByteSpan defaultValue(attributes[i].defaultValue.data(), attributes[i].defaultValue.size());
+        if (StoreValue(*values, entry, defaultValue, nullptr) != CHIP_NO_ERROR)
+        {
+            ChipLogError(Zcl, "AttributeStore: endpoint %d default for attribute " ChipLogFormatMEI " does not fit", endpoint,
+                         ChipLogValueMEI(entry.attributeId));
+            entry.flags = static_cast<uint8_t>(entry.flags & ~kFlag_Constant);
+            continue;
+        }
+        if (entry.flags & kFlag_Constant)
+        {
+            constantCount++;
+        }
+    }
+
+    // Slots keep their offsets, the entries are only ordered for FindEntry
+    std::stable_sort(values->entries.begin(), values->entries.end(), [](const Entry & a, const Entry & b) {
+        return std::make_pair(a.clusterId, a.attributeId) < std::make_pair(b.clusterId, b.attributeId);
+    });
+
+    ChipLogProgress(Zcl, "AttributeStore: endpoint %d tracks %u attributes (%u constant) in %u bytes", endpoint,
+                    static_cast<unsigned>(values->entries.size()), constantCount, static_cast<unsigned>(offset));
+    return values;
+}
+
+AttributeStore::StagingToken AttributeStore::Stage(EndpointId endpoint, const std::vector<AttributeDesc> & attributes)
+{
+    std::unique_ptr<EndpointValues> values = BuildValues(endpoint, attributes);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    if (endpoint != kInvalidEndpointId)
+    {
+        VerifyOrReturnValue(mStagedEndpoints.find(endpoint) == mStagedEndpoints.end(), kNoStaging,
+                            ChipLogError(Zcl, "AttributeStore: endpoint %d is already being added", endpoint));
+    }
+
+    StagingToken token = mNextStagingToken++;
+    if (endpoint != kInvalidEndpointId)
+    {
+        mStagedEndpoints[endpoint] = token;
+    }
+    mStaged[token] = StagedValues{ endpoint, std::move(values) };
+    return token;
+}
+
+CHIP_ERROR AttributeStore::SetStagedRawValue(StagingToken token, ClusterId clusterId, AttributeId attributeId, ByteSpan value)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mStaged.find(token);
+    VerifyOrReturnError(it != mStaged.end(), CHIP_ERROR_NOT_FOUND);
+    Entry * entry = FindEntry(*it->second.values, clusterId, attributeId);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError((entry->flags & kFlag_Constant) == 0, CHIP_ERROR_ACCESS_DENIED);
+
+    return StoreRawValue(*it->second.values, *entry, value, nullptr);
+}
+
+CHIP_ERROR AttributeStore::GetStagedRawValue(StagingToken token, ClusterId clusterId, AttributeId attributeId,
+                                             std::vector<uint8_t> & value)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mStaged.find(token);
+    VerifyOrReturnError(it != mStaged.end(), CHIP_ERROR_NOT_FOUND);
+    Entry * entry = FindEntry(*it->second.values, clusterId, attributeId);
+    VerifyOrReturnError(entry != nullptr && entry->valid, CHIP_ERROR_NOT_FOUND);
+
+    const uint8_t * slot = it->second.values->published.get() + entry->offset;
+    value.assign(slot, slot + entry->length);
+    return CHIP_NO_ERROR;
+}
+
+uint64_t AttributeStore::GetStagedGeneration(StagingToken token)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mStaged.find(token);
+    return (it == mStaged.end()) ? 0 : it->second.values->generation;
+}
+
+void AttributeStore::Install(StagingToken token, EndpointId endpoint, uint64_t * generation)
+{
+    std::unique_ptr<EndpointValues> previous; // freed once the lock is released, its block may be a Java buffer
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mStaged.find(token);
+    VerifyOrReturn(it != mStaged.end());
+    if (it->second.endpoint != kInvalidEndpointId)
+    {
+        mStagedEndpoints.erase(it->second.endpoint);
+    }
+    if (generation != nullptr)
+    {
+        *generation = it->second.values->generation;
+    }
+
+    // left over from a device that used the endpoint ID before, its Matter endpoint is gone already
+    std::unique_ptr<EndpointValues> & live = mEndpoints[endpoint];
+    previous                               = std::move(live);
+    live                                   = std::move(it->second.values);
+    mStaged.erase(it);
+}
+
+void AttributeStore::Unstage(StagingToken token)
+{
+    std::unique_ptr<EndpointValues> values; // freed once the lock is released
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mStaged.find(token);
+    VerifyOrReturn(it != mStaged.end());
+    if (it->second.endpoint != kInvalidEndpointId)
+    {
+        mStagedEndpoints.erase(it->second.endpoint);
+    }
+    values = std::move(it->second.values);
+    mStaged.erase(it);
+}
+
+void AttributeStore::RemoveEndpoint(EndpointId endpoint)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mEndpoints.erase(endpoint);
+}
+
+size_t AttributeStore::GetBlockSize(EndpointId endpoint)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    EndpointValues * values = FindValues(endpoint, Lookup::kStagedFirst);
+    return (values == nullptr) ? 0 : values->blockSize;
+}
+
+CHIP_ERROR AttributeStore::AttachBlock(EndpointId endpoint, std::shared_ptr<uint8_t> block, size_t blockSize)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    EndpointValues * values = FindValues(endpoint, Lookup::kStagedFirst);
+    VerifyOrReturnError(values != nullptr, CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError(block != nullptr && blockSize >= values->blockSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // Slot sequences come from the previous block, values from what was last published (native writes do not reach
+    // an attached block)
+    memcpy(block.get(), values->block.get(), values->blockSize);
+    for (const Entry & entry : values->entries)
+    {
+        if (entry.valid)
+        {
+            memcpy(block.get() + entry.offset, values->published.get() + entry.offset, entry.length);
+        }
+    }
+    values->block = std::move(block);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AttributeStore::GetSlot(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, uint32_t & offset,
+                                   uint16_t & capacity)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Entry * entry = FindEntry(endpoint, clusterId, attributeId, nullptr, Lookup::kStagedFirst);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NOT_FOUND);
+
+    offset   = entry->offset;
+    capacity = entry->capacity;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AttributeStore::MarkDirty(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, const uint8_t * block,
+                                     bool * changed)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    EndpointValues * values = nullptr;
+    Entry * entry           = FindEntry(endpoint, clusterId, attributeId, &values, Lookup::kStagedFirst);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError((entry->flags & kFlag_Constant) == 0, CHIP_ERROR_ACCESS_DENIED);
+    // The writer holds a block that was since replaced, e.g. the endpoint was removed and added again
+    VerifyOrReturnError(block == nullptr || block == values->block.get(), CHIP_ERROR_INCORRECT_STATE);
+
+    // Only a copy taken between two equal, even reads of the slot sequence holds a complete value
+    const uint8_t * slot = values->block.get() + entry->offset;
+    mScratch.resize(entry->capacity);
+    bool consistent = false;
+    for (int attempt = 0; attempt < kMaxCopyAttempts && !consistent; attempt++)
+    {
+        uint32_t sequence = LoadSequence(slot);
+        memcpy(mScratch.data(), slot, entry->capacity);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        consistent = (sequence & 1) == 0 && LoadSequence(slot) == sequence;
+    }
+    VerifyOrReturnError(consistent, CHIP_ERROR_BUSY);
+
+    uint16_t prefixSize = LengthPrefixSize(entry->type);
+    uint16_t length     = entry->capacity;
+    if (prefixSize > 0)
+    {
+        length = EncodedStringSize(prefixSize, mScratch.data());
+        VerifyOrReturnError(length <= entry->capacity, CHIP_ERROR_INVALID_STRING_LENGTH);
+    }
+
+    entry->length = length;
+    Publish(*values, *entry, mScratch.data(), changed);
+    return CHIP_NO_ERROR;
+}
+
+AttributeStore::EndpointValues * AttributeStore::FindValues(EndpointId endpoint, Lookup lookup)
+{
+    if (lookup == Lookup::kStagedFirst)
+    {
+        // Kotlin addresses a device being added (possibly re-using the ID of one being removed) by its endpoint ID
+        auto staged = mStagedEndpoints.find(endpoint);
+        if (staged != mStagedEndpoints.end())
+        {
+            return mStaged[staged->second].values.get();
+        }
+    }
+
+    auto it = mEndpoints.find(endpoint);
+    return (it == mEndpoints.end()) ? nullptr : it->second.get();
+}
+
+AttributeStore::Entry * AttributeStore::FindEntry(EndpointValues & values, ClusterId clusterId, AttributeId attributeId)
+{
+    auto key = std::make_pair(clusterId, attributeId);
+    auto it  = std::lower_bound(values.entries.begin(), values.entries.end(), key, [](const Entry & entry, const auto & k) {
+        return std::make_pair(entry.clusterId, entry.attributeId) < k;
+    });
+    VerifyOrReturnValue(it != values.entries.end() && it->clusterId == clusterId && it->attributeId == attributeId, nullptr);
+    return &*it;
+}
+
+AttributeStore::Entry * AttributeStore::FindEntry(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId,
+                                                  EndpointValues ** values, Lookup lookup)
+{
+    EndpointValues * endpointValues = FindValues(endpoint, lookup);
+    VerifyOrReturnValue(endpointValues != nullptr, nullptr);
+
+    Entry * entry = FindEntry(*endpointValues, clusterId, attributeId);
+    if (entry != nullptr && values != nullptr)
+    {
+        *values = endpointValues;
+    }
+    return entry;
+}
+
+CHIP_ERROR AttributeStore::SetValue(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, ByteSpan value,
+                                    bool * changed)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    EndpointValues * values = nullptr;
+    Entry * entry           = FindEntry(endpoint, clusterId, attributeId, &values, Lookup::kStagedFirst);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError((entry->flags & kFlag_Constant) == 0, CHIP_ERROR_ACCESS_DENIED);
+
+    return StoreValue(*values, *entry, value, changed);
+}
+
+CHIP_ERROR AttributeStore::StoreValue(EndpointValues & values, Entry & entry, ByteSpan value, bool * changed)
+{
+    uint8_t * slot      = values.local.get() + entry.offset;
+    uint16_t prefixSize = LengthPrefixSize(entry.type);
+
+    if (prefixSize > 0)
+    {
+        VerifyOrReturnError(value.size() + prefixSize <= entry.capacity, CHIP_ERROR_BUFFER_TOO_SMALL);
+        if (prefixSize == 1)
+        {
+            slot[0] = static_cast<uint8_t>(value.size());
+        }
+        else
+        {
+            Encoding::LittleEndian::Put16(slot, static_cast<uint16_t>(value.size()));
+        }
+        memcpy(slot + prefixSize, value.data(), value.size());
+        entry.length = static_cast<uint16_t>(prefixSize + value.size());
+    }
+    else
+    {
+        // Integers are little-endian: extra high-order bytes are dropped, missing ones are zero-filled.
+        size_t copyLength = std::min(value.size(), static_cast<size_t>(entry.capacity));
+        memcpy(slot, value.data(), copyLength);
+        memset(slot + copyLength, 0, entry.capacity - copyLength);
+        entry.length = entry.capacity;
+    }
+
+    Publish(values, entry, slot, changed);
+    return CHIP_NO_ERROR;
+}
+
+void AttributeStore::Publish(EndpointValues & values, Entry & entry, const uint8_t * value, bool * changed)
+{
+    uint8_t * previous = values.published.get() + entry.offset;
+    bool isChange      = !entry.valid || entry.length != entry.publishedLength || memcmp(value, previous, entry.length) != 0;
+    if (changed != nullptr)
+    {
+        *changed = isChange;
+    }
+    values.generation += isChange ? 1 : 0;
+
+    memcpy(previous, value, entry.length);
+    entry.publishedLength = entry.length;
+    entry.valid           = true;
+    entry.unsupported     = false;
+}
+
+CHIP_ERROR AttributeStore::SetValue(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, uint64_t value,
+                                    bool * changed)
+{
+    uint8_t encoded[sizeof(uint64_t)];
+    Encoding::LittleEndian::Put64(encoded, value);
+    return SetValue(endpoint, clusterId, attributeId, ByteSpan(encoded), changed);
+}
+
+CHIP_ERROR AttributeStore::SetRawValue(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, ByteSpan value,
+                                       bool * changed)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    EndpointValues * values = nullptr;
+    Entry * entry           = FindEntry(endpoint, clusterId, attributeId, &values);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError((entry->flags & kFlag_Constant) == 0, CHIP_ERROR_ACCESS_DENIED);
+
+    return StoreRawValue(*values, *entry, value, changed);
+}
+
+CHIP_ERROR AttributeStore::StoreRawValue(EndpointValues & values, Entry & entry, ByteSpan value, bool * changed)
+{
+    // Strings are sized from their own length prefix, fixed-size types from the metadata.
+    uint16_t prefixSize = LengthPrefixSize(entry.type);
+    size_t length       = entry.capacity;
+    if (prefixSize > 0)
+    {
+        VerifyOrReturnError(value.size() >= prefixSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+        length = EncodedStringSize(prefixSize, value.data());
+    }
+    VerifyOrReturnError(length <= value.size() && length <= entry.capacity, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    uint8_t * slot = values.local.get() + entry.offset;
+    memcpy(slot, value.data(), length);
+    entry.length = static_cast<uint16_t>(length);
+    Publish(values, entry, slot, changed);
+    return CHIP_NO_ERROR;
+}
+
+AttributeStore::ReadResult AttributeStore::Read(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId,
+                                                uint8_t * buffer, uint16_t maxReadLength)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    EndpointValues * values = nullptr;
+    Entry * entry           = FindEntry(endpoint, clusterId, attributeId, &values);
+    VerifyOrReturnValue(entry != nullptr, ReadResult::kUnknown);
+    if (entry->unsupported)
+    {
+        mNegativeCacheHits++;
+        return ReadResult::kUnsupported;
+    }
+    VerifyOrReturnValue((entry->flags & kFlag_JavaOwned) == 0, ReadResult::kJavaOwned);
+    if (!entry->valid)
+    {
+        mNegativeCacheMisses++;
+        return ReadResult::kMiss;
+    }
+    VerifyOrReturnValue(entry->length <= maxReadLength, ReadResult::kMiss);
+
+    memcpy(buffer, values->published.get() + entry->offset, entry->length);
+    return ReadResult::kHit;
+}
+
+CHIP_ERROR AttributeStore::GetRawValue(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId,
+                                       std::vector<uint8_t> & value)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    EndpointValues * values = nullptr;
+    Entry * entry           = FindEntry(endpoint, clusterId, attributeId, &values);
+    VerifyOrReturnError(entry != nullptr && entry->valid, CHIP_ERROR_NOT_FOUND);
+
+    const uint8_t * slot = values->published.get() + entry->offset;
+    value.assign(slot, slot + entry->length);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AttributeStore::GetIntegerValue(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, int64_t & value)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    EndpointValues * values = nullptr;
+    Entry * entry           = FindEntry(endpoint, clusterId, attributeId, &values, Lookup::kStagedFirst);
+    VerifyOrReturnError(entry != nullptr && entry->valid, CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError(LengthPrefixSize(entry->type) == 0 && entry->length > 0 && entry->length <= sizeof(uint64_t),
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint8_t * slot = values->published.get() + entry->offset;
+    uint64_t raw         = 0;
+    for (uint16_t i = 0; i < entry->length; i++)
+    {
+        raw |= static_cast<uint64_t>(slot[i]) << (8 * i);
+    }
+
+    unsigned unusedBits = 64u - 8u * entry->length;
+    if (IsSignedIntegerType(entry->type) && unusedBits > 0)
+    {
+        // shift the sign bit to the top and back
+        value = static_cast<int64_t>(raw << unusedBits) >> unusedBits;
+    }
+    else
+    {
+        value = static_cast<int64_t>(raw);
+    }
+    return CHIP_NO_ERROR;
+}
+
+bool AttributeStore::HasAttribute(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return FindEntry(endpoint, clusterId, attributeId, nullptr, Lookup::kStagedFirst) != nullptr;
+}
+
+uint8_t AttributeStore::GetFlags(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Entry * entry = FindEntry(endpoint, clusterId, attributeId);
+    return (entry != nullptr) ? entry->flags : 0;
+}
+
+void AttributeStore::MarkUnsupported(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Entry * entry = FindEntry(endpoint, clusterId, attributeId);
+    VerifyOrReturn(entry != nullptr && (entry->flags & kFlag_Constant) == 0);
+    entry->valid       = false;
+    entry->unsupported = true;
+}
+
+std::vector<app::ConcreteAttributePath> AttributeStore::GetUnresolved(EndpointId endpoint)
+{
+    std::vector<app::ConcreteAttributePath> paths;
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mEndpoints.find(endpoint);
+    VerifyOrReturnValue(it != mEndpoints.end(), paths);
+
+    for (const auto & entry : it->second->entries)
+    {
+        if ((!entry.valid || (entry.flags & kFlag_JavaOwned)) && !entry.unsupported)
+        {
+            paths.emplace_back(endpoint, entry.clusterId, entry.attributeId);
+        }
+    }
+    return paths;
+}
+
+void AttributeStore::Invalidate(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Entry * entry = FindEntry(endpoint, clusterId, attributeId);
+    VerifyOrReturn(entry != nullptr && (entry->flags & kFlag_Constant) == 0);
+    entry->valid       = false;
+    entry->unsupported = false;
+}
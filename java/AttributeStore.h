@@ -0,0 +1,231 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/util/attribute-storage.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Native shadow copy of the attribute values of bridged (dynamic) endpoints.
+ *
+ * Every endpoint gets one contiguous value block laid out from the attribute metadata passed to addBridgedDevice.
+ * Reads from the Matter thread are answered with a memcpy of the value last published there; Java is only consulted
+ * for attributes marked Java-owned, or for attributes whose value has not been pushed from Java yet.
+ *
+ * Values are kept in the same encoding the ember read/write callbacks use, i.e. strings carry their ZCL length prefix.
+ * Fixed-size values are naturally aligned within the block, so the block can be shared with Kotlin through a direct
+ * ByteBuffer (see AttachBlock) and written in place there, followed by a MarkDirty call.
+ */
+class AttributeStore
+{
+public:
+    enum Flags : uint8_t
+    {
+        // Always forwarded to Java and never cached natively.
+        kFlag_JavaOwned = 1u << 0,
+        // Immutable value given at registration, never overwritten or invalidated.
+        kFlag_Constant = 1u << 1,
+        // Controller writes are acknowledged natively and passed on to Java asynchronously (see WriteBehindQueue).
+        kFlag_WriteBehind = 1u << 2,
+    };
+
+    struct AttributeDesc
+    {
+        chip::ClusterId clusterId;
+        chip::AttributeId attributeId;
+        EmberAfAttributeType type;
+        uint16_t size;
+        uint8_t flags;
+        // initial value in SetValue encoding; with kFlag_Constant it is the only value the attribute ever has
+        std::vector<uint8_t> defaultValue;
+    };
+
+    enum class ReadResult
+    {
+        kHit,         // value copied into the caller's buffer
+        kMiss,        // attribute is known but has no native value (yet), ask Java
+        kJavaOwned,   // attribute is always answered by Java
+        kUnsupported, // Java did not handle the attribute last time and it has not been updated since
+        kUnknown,     // endpoint or attribute is not tracked by the store
+    };
+
+    static AttributeStore & GetInstance() { return sInstance; }
+
+    // bytes an ember-encoded value occupies: strings by their length prefix, other types by their size
+    static uint16_t EncodedValueSize(EmberAfAttributeType type, uint16_t size, const uint8_t * value);
+
+    // identifies a value block built by Stage, 0 for none
+    using StagingToken = uint64_t;
+    static constexpr StagingToken kNoStaging = 0;
+
+    // Builds the value block of an endpoint that is not live yet, on any thread. Until Install, the Java-facing calls
+    // below (SetValue, MarkDirty, AttachBlock, GetSlot, ...) on `endpoint` go to the staged block, so Kotlin can seed
+    // values while the device is being added; the Matter side only ever sees live blocks. kInvalidEndpointId stages a
+    // block only reachable through its token (endpoint assigned on publish). Returns kNoStaging if a block is already
+    // staged for the endpoint.
+    StagingToken Stage(chip::EndpointId endpoint, const std::vector<AttributeDesc> & attributes);
+    // stores a value in ember buffer encoding into a staged block, e.g. one restored from the registry snapshot
+    CHIP_ERROR SetStagedRawValue(StagingToken token, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                                 chip::ByteSpan value);
+    // copy of a value of a staged block, like GetRawValue
+    CHIP_ERROR GetStagedRawValue(StagingToken token, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                                 std::vector<uint8_t> & value);
+    // Counts the value changes of a staged block: work derived from its values while the device is prepared (e.g.
+    // DataVersion fingerprints) is stale if the generation passed on by Install differs.
+    uint64_t GetStagedGeneration(StagingToken token);
+    // moves a staged block in as the values of a live endpoint, once it is registered with the Matter SDK
+    void Install(StagingToken token, chip::EndpointId endpoint, uint64_t * generation = nullptr);
+    // drops a staged block that was not installed
+    void Unstage(StagingToken token);
+    // drops the values of a live endpoint; a block staged for the same endpoint ID is kept
+    void RemoveEndpoint(chip::EndpointId endpoint);
+
+    // size of the value block of an endpoint, 0 if the endpoint is not tracked
+    size_t GetBlockSize(chip::EndpointId endpoint);
+    // moves the values of an endpoint into caller-provided memory (e.g. a Java direct ByteBuffer), which the caller
+    // then writes in place; native writes no longer touch it. The shared_ptr deleter releases that memory once the
+    // endpoint is dropped or another block is attached.
+    CHIP_ERROR AttachBlock(chip::EndpointId endpoint, std::shared_ptr<uint8_t> block, size_t blockSize);
+    // offset of an attribute's slot in the endpoint block, strings start with their length prefix. The 4 bytes in front
+    // of the slot hold its write sequence: an in-place writer makes it odd while it writes and even again when done.
+    CHIP_ERROR GetSlot(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId, uint32_t & offset,
+                       uint16_t & capacity);
+    // The setters below report through `changed` whether the value differs from the previous one: the bytes last
+    // published are kept aside and compared, so re-posting an identical value can skip the attribute report.
+
+    // publishes a value written in place into `block` (nullptr: whichever block is attached); CHIP_ERROR_INCORRECT_STATE
+    // if that block is no longer the endpoint's, CHIP_ERROR_BUSY if no complete value could be copied out of the slot
+    CHIP_ERROR MarkDirty(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                         const uint8_t * block = nullptr, bool * changed = nullptr);
+
+    // stores a value pushed from Java; strings are given without their length prefix
+    CHIP_ERROR SetValue(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                        chip::ByteSpan value, bool * changed = nullptr);
+    // stores an integer value, truncated little-endian to the attribute size
+    CHIP_ERROR SetValue(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId, uint64_t value,
+                        bool * changed = nullptr);
+    // stores a value already in ember buffer encoding (Java read results, controller writes)
+    CHIP_ERROR SetRawValue(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                           chip::ByteSpan value, bool * changed = nullptr);
+
+    // copy of the current value in ember buffer encoding, CHIP_ERROR_NOT_FOUND if there is no native value
+    CHIP_ERROR GetRawValue(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                           std::vector<uint8_t> & value);
+
+    // current value of a fixed-size integer attribute, sign-extended for signed types; CHIP_ERROR_NOT_FOUND if there is
+    // no native value, CHIP_ERROR_INVALID_ARGUMENT for strings and values wider than 8 bytes
+    CHIP_ERROR GetIntegerValue(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                               int64_t & value);
+
+    // whether the attribute is part of an endpoint, live or being added (every registered attribute is tracked here)
+    bool HasAttribute(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId);
+
+    // flags the attribute was registered with, 0 if it is not tracked
+    uint8_t GetFlags(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId);
+
+    ReadResult Read(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId, uint8_t * buffer,
+                    uint16_t maxReadLength);
+
+    // negative cache: remembers that Java reported an attribute as unsupported, until its value is set again. Hits are
+    // reads answered kUnsupported, misses reads answered kMiss because nothing is cached for the attribute.
+    void MarkUnsupported(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId);
+    uint64_t GetNegativeCacheHits() const { return mNegativeCacheHits; }
+    uint64_t GetNegativeCacheMisses() const { return mNegativeCacheMisses; }
+
+    // attributes of an endpoint a read would currently have to fetch from Java (no native value, or Java-owned)
+    std::vector<chip::app::ConcreteAttributePath> GetUnresolved(chip::EndpointId endpoint);
+
+    // drops the cached value of an attribute, so the next read fetches it from Java again
+    void Invalidate(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId);
+
+private:
+    struct Entry
+    {
+        chip::ClusterId clusterId;
+        chip::AttributeId attributeId;
+        EmberAfAttributeType type;
+        uint8_t flags;
+        bool valid;
+        bool unsupported;
+        uint16_t capacity;        // slot size in bytes, including a string length prefix
+        uint16_t length;          // bytes currently held in the slot
+        uint32_t offset;          // slot offset in the endpoint block
+        uint16_t publishedLength; // bytes of the value last published (stored or marked dirty)
+    };
+
+    struct EndpointValues
+    {
+        std::vector<Entry> entries; // sorted by cluster and attribute ID
+        std::shared_ptr<uint8_t> block;
+        // where native writes are encoded: the block itself until Kotlin attaches a buffer, then only native, since the
+        // slot seqlock has a single writer
+        std::unique_ptr<uint8_t[]> local;
+        // copy of the values last published, at the same offsets; the block itself may be written in place by Kotlin,
+        // so reads are answered from here
+        std::unique_ptr<uint8_t[]> published;
+        size_t blockSize    = 0;
+        uint64_t generation = 0; // bumped by every published change
+    };
+
+    static AttributeStore sInstance;
+
+    // a block staged for an endpoint, see Stage
+    struct StagedValues
+    {
+        chip::EndpointId endpoint;
+        std::unique_ptr<EndpointValues> values;
+    };
+
+    // where FindEntry looks: Matter-side accesses only see live endpoints, Java writes reach a staged block first
+    enum class Lookup
+    {
+        kLive,
+        kStagedFirst,
+    };
+
+    static std::unique_ptr<EndpointValues> BuildValues(chip::EndpointId endpoint, const std::vector<AttributeDesc> & attributes);
+    static Entry * FindEntry(EndpointValues & values, chip::ClusterId clusterId, chip::AttributeId attributeId);
+    static CHIP_ERROR StoreRawValue(EndpointValues & values, Entry & entry, chip::ByteSpan value, bool * changed);
+    static CHIP_ERROR StoreValue(EndpointValues & values, Entry & entry, chip::ByteSpan value, bool * changed);
+    // makes `value` (entry.length bytes) the entry's current value
+    static void Publish(EndpointValues & values, Entry & entry, const uint8_t * value, bool * changed);
+
+    EndpointValues * FindValues(chip::EndpointId endpoint, Lookup lookup);
+    Entry * FindEntry(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                      EndpointValues ** values = nullptr, Lookup lookup = Lookup::kLive);
+
+    std::mutex mLock;
+    std::atomic<uint64_t> mNegativeCacheHits{ 0 };
+    std::atomic<uint64_t> mNegativeCacheMisses{ 0 };
+    std::map<chip::EndpointId, std::unique_ptr<EndpointValues>> mEndpoints;
+    std::map<StagingToken, StagedValues> mStaged;
+    std::map<chip::EndpointId, StagingToken> mStagedEndpoints;
+    StagingToken mNextStagingToken = 1;
+    std::vector<uint8_t> mScratch; // slot copy taken by MarkDirty
+};
@@ -17,9 +17,22 @@
  */
 
 #include "AppImpl.h"
+#include "AttributeStore.h"
+#include "DataVersionStore.h"
+#include "JniEnvCache.h"
 #include "JNIDACProvider.h"
+#include "LatencyTracer.h"
+#include "RegistrySnapshot.h"
+#include "ReportQueue.h"
+#include "ReportThrottle.h"
 #include "BridgeApp-JNI.h"
 #include "Device.h"
+#include "EndpointAllocator.h"
+#include "EndpointTable.h"
+#include "EndpointTemplates.h"
+#include "MetadataArena.h"
+#include "WorkerPool.h"
+#include "WriteBehindQueue.h"
 #include "main.h"
 
 #include <app-common/zap-generated/ids/Attributes.h>
@@ -34,6 +47,7 @@
 #include <app/util/util.h>
 #include <credentials/DeviceAttestationCredsProvider.h>
 #include <credentials/examples/DeviceAttestationCredsExample.h>
+#include <lib/core/CHIPEncoding.h>
 #include <lib/core/CHIPError.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/ZclString.h>
@@ -49,10 +63,21 @@
 #include <app/CommandHandlerInterfaceRegistry.h>
 
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cinttypes>
+#include <cstdlib>
+#include <initializer_list>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <android/log.h>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace chip;
@@ -98,7 +123,6 @@ DECLARE_DYNAMIC_ATTRIBUTE(BridgedDeviceBasicInformation::Attributes::NodeLabel::
     DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
 // Unused constants removed
 
-EndpointId gCurrentEndpointId;
 EndpointId gFirstDynamicEndpointId;
 // Power source is on the same endpoint as the composed device
 Device * gDevices[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT + 1];
@@ -207,17 +231,6 @@ Device * gDevices[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT + 1];
 // Track which devices are dynamically allocated (vs static from postServerInit)
 static bool gDynamicDevices[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT] = {false};
 
-// Device type tracking (since RTTI is disabled)
-enum class DeviceType
-{
-    Unknown,
-    OnOff,
-    TempSensor,
-    OnOffLightSwitch,
-    Generic // New generic type
-};
-static DeviceType gDeviceTypes[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT] = {DeviceType::Unknown};
-
 // Generic Device Implementation
 class DeviceGeneric : public Device
 {
@@ -245,16 +258,17 @@ private:
     std::map<chip::ClusterId, std::map<chip::AttributeId, uint64_t>> mAttributes;
 };
 
-// Dynamic Endpoint Memory Management
-struct DynamicEndpointData {
-    std::vector<EmberAfCluster> clusters;
-    std::vector<std::vector<EmberAfAttributeMetadata>> attributes; // Attributes per cluster
-    EmberAfEndpointType endpointType;
-    DataVersion* dataVersions;
-    std::vector<EmberAfDeviceType> deviceTypes;
-};
+// Dynamic Endpoint Memory Management: the endpoint definition is shared through EndpointTemplateRegistry, each
+// generic device only owns the DataVersion storage of its clusters, in an arena returned when the endpoint is cleared
+struct DynamicEndpointMetadata
+{
+    const EndpointTemplate * endpointTemplate = nullptr; // device reference, see EndpointTemplateRegistry::Acquire
+    DataVersion * dataVersions                = nullptr;
+    MetadataArena arena;
 
-static std::vector<DynamicEndpointData*> gDynamicEndpoints;
+    ~DynamicEndpointMetadata() { EndpointTemplateRegistry::GetInstance().Release(endpointTemplate); }
+};
+static std::unique_ptr<DynamicEndpointMetadata> gEndpointMetadata[CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT];
 
 // Define accepted command lists for clusters
 constexpr CommandId onOffIncomingCommands[] = {
@@ -264,6 +278,18 @@ constexpr CommandId onOffIncomingCommands[] = {
     kInvalidCommandId,
 };
 
+// Accepted command list of a generic device cluster, nullptr if it has no commands
+const CommandId * AcceptedCommandsFor(chip::ClusterId clusterId)
+{
+    return (clusterId == OnOff::Id) ? onOffIncomingCommands : nullptr;
+}
+
+// Re-creates the devices of the registry snapshot in two steps: prepared on the calling thread and the WorkerPool
+// before the Matter thread is asked to publish them, once dynamic endpoints can be added
+void PrepareRegistrySnapshot();
+void PublishRegistrySnapshot();
+void DiscardRegistrySnapshot();
+
 // Helper to create attributes for common clusters
 std::vector<EmberAfAttributeMetadata> GetAttributesForCluster(chip::ClusterId clusterId)
 {
@@ -295,96 +321,91 @@ int AddDeviceEndpoint(Device * dev, EmberAfEndpointType * ep, const Span<const E
 #endif
                       chip::EndpointId parentEndpointId = chip::kInvalidEndpointId)
 {
-    uint8_t index = 0;
-    while (index < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT)
+    EndpointAllocator & allocator = EndpointAllocator::GetInstance();
+
+    int index = allocator.AllocateSlot();
+    if (index < 0)
     {
-        if (nullptr == gDevices[index])
+        ChipLogProgress(DeviceLayer, "Failed to add dynamic endpoint: No endpoints available!");
+        return -1;
+    }
+
+    gDevices[index] = dev;
+    CHIP_ERROR err;
+    while (true)
+    {
+        // Todo: Update this to schedule the work rather than use this lock
+        // DeviceLayer::StackLock lock; // Removed to avoid deadlock in ScheduleWork
+
+        chip::EndpointId endpointToUse = requestedEndpointId;
+        if (requestedEndpointId != chip::kInvalidEndpointId)
         {
-            gDevices[index] = dev;
-            CHIP_ERROR err;
-            while (true)
+            if (!allocator.Claim(requestedEndpointId))
             {
-                // Todo: Update this to schedule the work rather than use this lock
-                // DeviceLayer::StackLock lock; // Removed to avoid deadlock in ScheduleWork
-                
-                chip::EndpointId endpointToUse = (requestedEndpointId != chip::kInvalidEndpointId) ? requestedEndpointId : gCurrentEndpointId;
-                
-                dev->SetEndpointId(endpointToUse);
-                dev->SetParentEndpointId(parentEndpointId);
+                ChipLogError(DeviceLayer, "Failed to add dynamic endpoint: endpoint %d is in use", requestedEndpointId);
+                break;
+            }
+        }
+        else
+        {
+            endpointToUse = allocator.Allocate();
+            if (endpointToUse == chip::kInvalidEndpointId)
+            {
+                break;
+            }
+        }
+
+        dev->SetEndpointId(endpointToUse);
+        dev->SetParentEndpointId(parentEndpointId);
 #if !CHIP_CONFIG_USE_ENDPOINT_UNIQUE_ID
-                err =
-                    emberAfSetDynamicEndpoint(index, endpointToUse, ep, dataVersionStorage, deviceTypeList, parentEndpointId);
+        err = emberAfSetDynamicEndpoint(static_cast<uint16_t>(index), endpointToUse, ep, dataVersionStorage, deviceTypeList,
+                                        parentEndpointId);
 #else
-                err = emberAfSetDynamicEndpointWithEpUniqueId(index, endpointToUse, ep, dataVersionStorage, deviceTypeList,
-                                                              epUniqueId, parentEndpointId);
+        err = emberAfSetDynamicEndpointWithEpUniqueId(static_cast<uint16_t>(index), endpointToUse, ep, dataVersionStorage,
+                                                      deviceTypeList, epUniqueId, parentEndpointId);
 #endif
-                if (err == CHIP_NO_ERROR)
-                {
-                    ChipLogProgress(DeviceLayer, "Added device %s to dynamic endpoint %d (index=%d)", dev->GetName(),
-                                    endpointToUse, index);
-
-                    if (dev->GetUniqueId()[0] == '\0')
-                    {
-                        dev->GenerateUniqueId();
-                    }
-
-                    // Only increment gCurrentEndpointId if we used it
-                    if (requestedEndpointId == chip::kInvalidEndpointId)
-                    {
-                        // Handle wrap condition
-                        if (++gCurrentEndpointId < gFirstDynamicEndpointId)
-                        {
-                            gCurrentEndpointId = gFirstDynamicEndpointId;
-                        }
-                    }
-
-                    return index;
-                }
-                if (err != CHIP_ERROR_ENDPOINT_EXISTS)
-                {
-                    gDevices[index] = nullptr;
-                    return -1;
-                }
-                
-                // If we requested a specific endpoint and it failed, abort
-                if (requestedEndpointId != chip::kInvalidEndpointId)
-                {
-                    gDevices[index] = nullptr;
-                    return -1;
-                }
+        if (err == CHIP_NO_ERROR)
+        {
+            // the device is fully prepared by its caller, only the tables are updated here
+            EndpointTable::GetInstance().Insert(endpointToUse, static_cast<uint16_t>(index), dev);
+            return index;
+        }
 
-                // Handle wrap condition for auto-assigned endpoints
-                if (++gCurrentEndpointId < gFirstDynamicEndpointId)
-                {
-                    gCurrentEndpointId = gFirstDynamicEndpointId;
-                }
-            }
+        if (err != CHIP_ERROR_ENDPOINT_EXISTS)
+        {
+            allocator.Release(endpointToUse);
+            break;
+        }
+        // The ID is taken outside the allocator's knowledge: it stays marked used. A requested endpoint fails,
+        // an auto-assigned one moves on to the next free ID.
+        if (requestedEndpointId != chip::kInvalidEndpointId)
+        {
+            break;
         }
-        index++;
     }
-    ChipLogProgress(DeviceLayer, "Failed to add dynamic endpoint: No endpoints available!");
+
+    gDevices[index] = nullptr;
+    allocator.ReleaseSlot(static_cast<uint16_t>(index));
     return -1;
 }
 
 int RemoveDeviceEndpoint(Device * dev)
 {
-    uint8_t index = 0;
-    while (index < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT)
+    EndpointTable::Entry entry = EndpointTable::GetInstance().Find(dev->GetEndpointId());
+    if (entry.device != dev || entry.slot >= CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT)
     {
-        if (gDevices[index] == dev)
-        {
-            // Todo: Update this to schedule the work rather than use this lock
-            // DeviceLayer::StackLock lock; // Removed to avoid deadlock in ScheduleWork
-            // Silence complaints about unused ep when progress logging
-            // disabled.
-            [[maybe_unused]] EndpointId ep = emberAfClearDynamicEndpoint(index);
-            gDevices[index]                = nullptr;
-            ChipLogProgress(DeviceLayer, "Removed device %s from dynamic endpoint %d (index=%d)", dev->GetName(), ep, index);
-            return index;
-        }
-        index++;
-    }
-    return -1;
+        return -1;
+    }
+
+    // Todo: Update this to schedule the work rather than use this lock
+    // DeviceLayer::StackLock lock; // Removed to avoid deadlock in ScheduleWork
+    EndpointTable::GetInstance().Remove(dev->GetEndpointId());
+    EndpointId ep        = emberAfClearDynamicEndpoint(entry.slot);
+    gDevices[entry.slot] = nullptr;
+    EndpointAllocator::GetInstance().Release(ep);
+    EndpointAllocator::GetInstance().ReleaseSlot(entry.slot);
+    ChipLogProgress(DeviceLayer, "Removed device %s from dynamic endpoint %d (index=%d)", dev->GetName(), ep, entry.slot);
+    return entry.slot;
 }
 
 std::vector<EndpointListInfo> GetEndpointListInfo(chip::EndpointId parentId)
@@ -438,17 +459,55 @@ std::vector<Room *> GetRoomListInfo(chip::EndpointId parentId)
 }
 
 namespace {
-void CallReportingCallback(intptr_t closure)
+void ScheduleReportingCallback(EndpointId endpoint, ClusterId cluster, AttributeId attribute)
 {
-    auto path = reinterpret_cast<app::ConcreteAttributePath *>(closure);
-    MatterReportingAttributeChangeCallback(*path);
-    Platform::Delete(path);
+    ReportQueue::GetInstance().Push(endpoint, cluster, attribute);
 }
 
 void ScheduleReportingCallback(Device * dev, ClusterId cluster, AttributeId attribute)
 {
-    auto * path = Platform::New<app::ConcreteAttributePath>(dev->GetEndpointId(), cluster, attribute);
-    PlatformMgr().ScheduleWork(CallReportingCallback, reinterpret_cast<intptr_t>(path));
+    ScheduleReportingCallback(dev->GetEndpointId(), cluster, attribute);
+}
+
+// Updates from Java that left the stored value as it was and therefore were not reported
+std::atomic<uint64_t> gUnchangedUpdates{ 0 };
+
+// Reports a value pushed from Java, unless it is identical to the value already stored: reporting it would only
+// bump the cluster DataVersion and wake every subscriber for nothing. Numeric values are also held back while they
+// stay within their reportable-change threshold, see ReportThrottle.
+void ReportUpdate(EndpointId endpoint, ClusterId cluster, AttributeId attribute, bool changed)
+{
+    if (!changed)
+    {
+        gUnchangedUpdates++;
+        return;
+    }
+
+    int64_t value;
+    if (AttributeStore::GetInstance().GetIntegerValue(endpoint, cluster, attribute, value) == CHIP_NO_ERROR &&
+        !ReportThrottle::GetInstance().ShouldReport(endpoint, cluster, attribute, value))
+    {
+        return;
+    }
+    ScheduleReportingCallback(endpoint, cluster, attribute);
+}
+
+// Measured values of sensors are reported once they moved by a tenth of their unit (0.1 degC, 0.1 %RH), and at
+// least every 30 s while they drift below that. Java can override these per endpoint with setReportingThreshold,
+// before or after the device is added.
+constexpr int64_t kMeasurementDeadband           = 10;
+constexpr uint32_t kMeasurementMaxReportInterval = 30000;
+
+void ConfigureDefaultReportingThresholds()
+{
+    ReportThrottle::Threshold threshold;
+    threshold.absoluteDelta = kMeasurementDeadband;
+    threshold.maxIntervalMs = kMeasurementMaxReportInterval;
+
+    ReportThrottle::GetInstance().ConfigureDefault(TemperatureMeasurement::Id,
+                                                   TemperatureMeasurement::Attributes::MeasuredValue::Id, threshold);
+    ReportThrottle::GetInstance().ConfigureDefault(RelativeHumidityMeasurement::Id,
+                                                   RelativeHumidityMeasurement::Attributes::MeasuredValue::Id, threshold);
 }
 } // anonymous namespace
 
@@ -509,7 +568,9 @@ void HandleDeviceTempSensorStatusChanged(DeviceTempSensor * dev, DeviceTempSenso
     {
         HandleDeviceStatusChanged(static_cast<Device *>(dev), (Device::Changed_t) itemChangedMask);
     }
-    if (itemChangedMask & DeviceTempSensor::kChanged_MeasurementValue)
+    if ((itemChangedMask & DeviceTempSensor::kChanged_MeasurementValue) &&
+        ReportThrottle::GetInstance().ShouldReport(dev->GetEndpointId(), TemperatureMeasurement::Id,
+                                                   TemperatureMeasurement::Attributes::MeasuredValue::Id, dev->GetMeasuredValue()))
     {
         ScheduleReportingCallback(dev, TemperatureMeasurement::Id, TemperatureMeasurement::Attributes::MeasuredValue::Id);
     }
@@ -583,26 +644,113 @@ Protocols::InteractionModel::Status HandleWriteBridgedDeviceBasicAttribute(Devic
 
     HandleDeviceStatusChanged(dev, Device::kChanged_Name);
     
-    // Notify Java layer of state change
-    uint64_t hashValue = std::hash<std::string>{}(name);
-    BridgeAppJNIMgr().PostDeviceStateChanged(dev->GetEndpointId(), BridgedDeviceBasicInformation::Id, 
-                                            static_cast<int>(attributeId), reinterpret_cast<uint8_t*>(&hashValue), sizeof(hashValue));
+    // Notify Java layer of state change with the UTF-8 label, without its length prefix
+    BridgeAppJNIMgr().PostDeviceStateChanged(dev->GetEndpointId(), BridgedDeviceBasicInformation::Id,
+                                             static_cast<int>(attributeId),
+                                             reinterpret_cast<uint8_t *>(const_cast<char *>(nameSpan.data())), nameSpan.size());
 
     return Protocols::InteractionModel::Status::Success;
 }
 
 
+namespace {
+
+// Values of one endpoint fetched from Java in a single batched upcall. A wildcard read or a subscription priming
+// calls the read callback once per attribute within the same event-loop turn, so the first miss fetches every
+// unresolved attribute of the endpoint and the prefetch is dropped once that turn is over.
+constexpr uint16_t kPrefetchUnhandled = 0xFFFF;
+
+struct ReadPrefetch
+{
+    struct Value
+    {
+        ClusterId clusterId;
+        AttributeId attributeId;
+        size_t offset;
+        uint16_t length; // kPrefetchUnhandled when Java did not handle the attribute
+    };
+
+    EndpointId endpoint = kInvalidEndpointId;
+    std::vector<Value> values;
+    std::vector<uint8_t> data;
+};
+
+ReadPrefetch gReadPrefetch;
+
+void ClearReadPrefetch(intptr_t)
+{
+    gReadPrefetch.endpoint = kInvalidEndpointId;
+    gReadPrefetch.values.clear();
+    gReadPrefetch.data.clear();
+}
+
+void PrefetchEndpointAttributes(EndpointId endpoint)
+{
+    std::vector<ConcreteAttributePath> paths = AttributeStore::GetInstance().GetUnresolved(endpoint);
+    // A single attribute is no cheaper batched
+    VerifyOrReturn(paths.size() > 1);
+
+    // Drop the prefetch at the end of this event-loop turn; without that guarantee do not keep it at all
+    VerifyOrReturn(PlatformMgr().ScheduleWork(ClearReadPrefetch) == CHIP_NO_ERROR,
+                   ChipLogError(Zcl, "PrefetchEndpointAttributes: failed to schedule prefetch cleanup"));
+
+    // Claimed before the upcall: if it fails, the other misses of this turn go straight to single reads
+    ClearReadPrefetch(0);
+    gReadPrefetch.endpoint = endpoint;
+
+    std::vector<uint8_t> packed;
+    VerifyOrReturn(BridgeAppJNIMgr().HandleEndpointAttributesRead(endpoint, paths, packed),
+                   ChipLogError(Zcl, "PrefetchEndpointAttributes: batched read of endpoint %d failed", endpoint));
+
+    size_t pos = 0;
+    for (const auto & path : paths)
+    {
+        if (pos + sizeof(uint16_t) > packed.size())
+        {
+            break;
+        }
+        uint16_t length = Encoding::LittleEndian::Get16(&packed[pos]);
+        pos += sizeof(uint16_t);
+        if (length != kPrefetchUnhandled && pos + length > packed.size())
+        {
+            ChipLogError(Zcl, "PrefetchEndpointAttributes: truncated value for endpoint %d", endpoint);
+            break;
+        }
+        gReadPrefetch.values.push_back({ path.mClusterId, path.mAttributeId, pos, length });
+        // An unhandled mark is only trusted for this turn: it cannot tell an unsupported attribute from a missing value
+        if (length != kPrefetchUnhandled)
+        {
+            pos += length;
+        }
+    }
+    gReadPrefetch.data = std::move(packed);
+}
+
+const ReadPrefetch::Value * FindPrefetched(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    VerifyOrReturnValue(gReadPrefetch.endpoint == endpoint, nullptr);
+    for (const auto & value : gReadPrefetch.values)
+    {
+        if (value.clusterId == clusterId && value.attributeId == attributeId)
+        {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
 Protocols::InteractionModel::Status emberAfExternalAttributeReadCallback(EndpointId endpoint, ClusterId clusterId,
                                                                          const EmberAfAttributeMetadata * attributeMetadata,
                                                                          uint8_t * buffer, uint16_t maxReadLength)
 {
-    uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(endpoint);
+    Device * dev = EndpointTable::GetInstance().GetDevice(endpoint);
 
     Protocols::InteractionModel::Status ret = Protocols::InteractionModel::Status::Failure;
 
-    if ((endpointIndex < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT) && (gDevices[endpointIndex] != nullptr))
+    if (dev != nullptr)
     {
-        Device * dev = gDevices[endpointIndex];
 
         // Handle BridgedDeviceBasicInformation in C++ (infrastructure cluster)
         if (clusterId == BridgedDeviceBasicInformation::Id)
@@ -611,17 +759,68 @@ Protocols::InteractionModel::Status emberAfExternalAttributeReadCallback(Endpoin
         }
         else
         {
-            // Forward all other clusters to Java/Kotlin layer for handling
-            auto result = BridgeAppJNIMgr().HandleClusterAttributeRead(endpoint, static_cast<int>(clusterId), static_cast<int>(attributeMetadata->attributeId), maxReadLength);
-            
-            if (result.data() != nullptr && result.size() > 0 && result.size() <= maxReadLength)
+            // Serve the value from the native shadow store when Java has already pushed it
+            AttributeStore::ReadResult cached =
+                AttributeStore::GetInstance().Read(endpoint, clusterId, attributeMetadata->attributeId, buffer, maxReadLength);
+            if (cached == AttributeStore::ReadResult::kHit)
+            {
+                return Protocols::InteractionModel::Status::Success;
+            }
+            // Java answered null last time and the attribute has not been updated since
+            VerifyOrReturnValue(cached != AttributeStore::ReadResult::kUnsupported,
+                                Protocols::InteractionModel::Status::UnsupportedAttribute);
+
+            // First miss of a read burst: fetch the rest of the endpoint from Java in one crossing
+            if (cached != AttributeStore::ReadResult::kUnknown)
+            {
+                if (gReadPrefetch.endpoint != endpoint)
+                {
+                    PrefetchEndpointAttributes(endpoint);
+                }
+
+                const ReadPrefetch::Value * prefetched = FindPrefetched(endpoint, clusterId, attributeMetadata->attributeId);
+                if (prefetched != nullptr)
+                {
+                    VerifyOrReturnValue(prefetched->length != kPrefetchUnhandled && prefetched->length > 0 &&
+                                            prefetched->length <= maxReadLength,
+                                        Protocols::InteractionModel::Status::UnsupportedAttribute);
+
+                    ByteSpan value(&gReadPrefetch.data[prefetched->offset], prefetched->length);
+                    memcpy(buffer, value.data(), value.size());
+                    if (cached == AttributeStore::ReadResult::kMiss)
+                    {
+                        AttributeStore::GetInstance().SetRawValue(endpoint, clusterId, attributeMetadata->attributeId, value);
+                    }
+                    return Protocols::InteractionModel::Status::Success;
+                }
+            }
+
+            // Otherwise forward to Java/Kotlin layer for handling
+            int length = BridgeAppJNIMgr().ReadClusterAttribute(endpoint, static_cast<int>(clusterId),
+                                                                static_cast<int>(attributeMetadata->attributeId), buffer,
+                                                                maxReadLength);
+
+            if (length > 0)
             {
-                memcpy(buffer, result.data(), static_cast<size_t>(result.size()));
                 ret = Protocols::InteractionModel::Status::Success;
+
+                // Keep the answer so the next read stays native
+                if (cached == AttributeStore::ReadResult::kMiss)
+                {
+                    AttributeStore::GetInstance().SetRawValue(endpoint, clusterId, attributeMetadata->attributeId,
+                                                              ByteSpan(buffer, static_cast<size_t>(length)));
+                }
             }
             else
             {
-                ret = Protocols::InteractionModel::Status::UnsupportedAttribute;
+                // Remember an explicit "unsupported" so repeated reads of this attribute stay native
+                if (length == BridgeAppJNI::kReadUnhandled && cached != AttributeStore::ReadResult::kUnknown)
+                {
+                    AttributeStore::GetInstance().MarkUnsupported(endpoint, clusterId, attributeMetadata->attributeId);
+                }
+                // A value that does not fit is not an unsupported attribute, fail this read only
+                ret = (length == BridgeAppJNI::kReadTooLarge) ? Protocols::InteractionModel::Status::ResourceExhausted
+                                                              : Protocols::InteractionModel::Status::UnsupportedAttribute;
             }
         }
     }
@@ -704,15 +903,13 @@ Protocols::InteractionModel::Status emberAfExternalAttributeWriteCallback(Endpoi
                                                                           const EmberAfAttributeMetadata * attributeMetadata,
                                                                           uint8_t * buffer)
 {
-    uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(endpoint);
+    Device * dev = EndpointTable::GetInstance().GetDevice(endpoint);
 
     Protocols::InteractionModel::Status ret = Protocols::InteractionModel::Status::Failure;
 
-    if (endpointIndex < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT)
+    if (dev != nullptr)
     {
-        Device * dev = gDevices[endpointIndex];
-
-        if (!dev || !dev->IsReachable())
+        if (!dev->IsReachable())
         {
             return Protocols::InteractionModel::Status::Failure;
         }
@@ -724,22 +921,44 @@ Protocols::InteractionModel::Status emberAfExternalAttributeWriteCallback(Endpoi
         }
         else
         {
+            LatencyTracer::TraceId trace = LatencyTracer::GetInstance().Begin(endpoint, clusterId, /* isCommand */ false);
+
+            // Cross JNI with exactly the encoded value: strings up to the end of their data, other types by size
+            size_t bufferSize =
+                AttributeStore::EncodedValueSize(attributeMetadata->attributeType, attributeMetadata->size, buffer);
+
+            // Write-behind: acknowledge from native state, Java is told on the write-behind thread
+            uint8_t flags = AttributeStore::GetInstance().GetFlags(endpoint, clusterId, attributeMetadata->attributeId);
+            if ((flags & AttributeStore::kFlag_WriteBehind) && !(flags & AttributeStore::kFlag_JavaOwned))
+            {
+                VerifyOrReturnValue(WriteBehindQueue::GetInstance().Commit(endpoint, clusterId, attributeMetadata->attributeId,
+                                                                           ByteSpan(buffer, bufferSize)) == CHIP_NO_ERROR,
+                                    Protocols::InteractionModel::Status::Failure);
+                ScheduleReportingCallback(endpoint, clusterId, attributeMetadata->attributeId);
+                return Protocols::InteractionModel::Status::Success;
+            }
+
             // Forward all other clusters to Java/Kotlin layer for handling
             ChipLogProgress(DeviceLayer, "HandleClusterAttributeWrite: Forwarding to Java - ep=%d, cluster=0x%x, attr=0x%x",
                           endpoint, clusterId, attributeMetadata->attributeId);
-            
-            // Determine buffer size - use reasonable max for most attribute types
-            // For more complex types, this should be derived from attribute metadata
-            size_t bufferSize = 8; // Most attributes are <= 8 bytes (bool, int8-64, etc.)
-            
+
+            LatencyTracer::GetInstance().Mark(trace, LatencyTracer::Stage::kJniEnter);
             bool handled = BridgeAppJNIMgr().HandleClusterAttributeWrite(endpoint, static_cast<int>(clusterId), static_cast<int>(attributeMetadata->attributeId), buffer, bufferSize);
+            LatencyTracer::GetInstance().Mark(trace, LatencyTracer::Stage::kJniExit);
             
             if (handled)
             {
                 ChipLogProgress(DeviceLayer, "HandleClusterAttributeWrite: Java handled write successfully");
+
+                // Mirror the accepted value into the shadow store, or drop the stale copy if it does not fit
+                if (AttributeStore::GetInstance().SetRawValue(endpoint, clusterId, attributeMetadata->attributeId,
+                                                              ByteSpan(buffer, bufferSize)) != CHIP_NO_ERROR)
+                {
+                    AttributeStore::GetInstance().Invalidate(endpoint, clusterId, attributeMetadata->attributeId);
+                }
                 
-                // Report attribute change to subscribed controllers
-                MatterReportingAttributeChangeCallback(endpoint, clusterId, attributeMetadata->attributeId);
+                // Report attribute change to subscribed controllers, merged with the report of any update Java made
+                ScheduleReportingCallback(endpoint, clusterId, attributeMetadata->attributeId);
                 
                 // Trigger state change callback for UI updates with the actual buffer data
                 BridgeAppJNIMgr().PostDeviceStateChanged(endpoint, static_cast<int>(clusterId), static_cast<int>(attributeMetadata->attributeId), buffer, bufferSize);
@@ -771,6 +990,10 @@ Protocols::InteractionModel::Status emberAfExternalAttributeWriteCallback(Endpoi
 [[maybe_unused]] const EmberAfDeviceType gBridgedTempSensorDeviceTypes[] = { { DEVICE_TYPE_TEMP_SENSOR, DEVICE_VERSION_DEFAULT },
                                                             { DEVICE_TYPE_BRIDGED_NODE, DEVICE_VERSION_DEFAULT } };
 
+#ifndef BRIDGE_APP_READ_BENCHMARK
+#define BRIDGE_APP_READ_BENCHMARK 0
+#endif
+
 #define JNI_METHOD(RETURN, METHOD_NAME)                                                                                            \
     extern "C" JNIEXPORT RETURN JNICALL Java_com_matter_bridge_app_BridgeApp_##METHOD_NAME
 
@@ -779,10 +1002,36 @@ Protocols::InteractionModel::Status emberAfExternalAttributeWriteCallback(Endpoi
 EmberAfDeviceType gDeviceTypeIds[] = { { 0, DEVICE_VERSION_DEFAULT } };
 BridgeAppJNI BridgeAppJNI::sInstance;
 
+namespace {
+
+struct FieldLookup
+{
+    jfieldID * field;
+    const char * name;
+    const char * signature;
+};
+
+// Resolves the fields in order and stops at the first one that is missing, with its NoSuchFieldError still pending
+bool ResolveFields(JNIEnv * env, jclass clazz, std::initializer_list<FieldLookup> lookups)
+{
+    for (const FieldLookup & lookup : lookups)
+    {
+        *lookup.field = env->GetFieldID(clazz, lookup.name, lookup.signature);
+        if (*lookup.field == nullptr || env->ExceptionCheck())
+        {
+            ChipLogError(Zcl, "Failed to access field '%s'", lookup.name);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 void BridgeAppJNI::InitializeWithObjects(jobject app)
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
-    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "Failed to GetEnvForCurrentThread for BridgeAppJNI"));
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "Failed to get JNIEnv for BridgeAppJNI"));
 
     VerifyOrReturn(mDeviceAppObject.Init(app) == CHIP_NO_ERROR, ChipLogError(Zcl, "Failed to init mDeviceAppObject"));
 
@@ -810,6 +1059,28 @@ void BridgeAppJNI::InitializeWithObjects(jobject app)
         env->ExceptionClear();
     }
 
+    mPostDeviceStateChangedBatchMethod = env->GetMethodID(managerClass, "postDeviceStateChangedBatch", "([I[I[I[B[I)V");
+    if (mPostDeviceStateChangedBatchMethod == nullptr)
+    {
+        ChipLogError(Zcl, "Failed to access BridgeApp 'postDeviceStateChangedBatch' method");
+        env->ExceptionClear();
+    }
+
+    mPostBridgedDevicesAddedMethod = env->GetMethodID(managerClass, "postBridgedDevicesAdded", "(I[IJ)V");
+    if (mPostBridgedDevicesAddedMethod == nullptr)
+    {
+        ChipLogError(Zcl, "Failed to access BridgeApp 'postBridgedDevicesAdded' method");
+        env->ExceptionClear();
+    }
+
+    mPostBridgedDevicesRestoredMethod =
+        env->GetMethodID(managerClass, "postBridgedDevicesRestored", "([I[I[Ljava/lang/String;[[I[[IJ)V");
+    if (mPostBridgedDevicesRestoredMethod == nullptr)
+    {
+        ChipLogError(Zcl, "Failed to access BridgeApp 'postBridgedDevicesRestored' method");
+        env->ExceptionClear();
+    }
+
     mOnAttributeReadMethod = env->GetMethodID(managerClass, "onClusterAttributeReadRequest", "(IIII)[B");
     if (mOnAttributeReadMethod == nullptr)
     {
@@ -817,6 +1088,21 @@ void BridgeAppJNI::InitializeWithObjects(jobject app)
         env->ExceptionClear();
     }
 
+    mOnAttributeReadDirectMethod =
+        env->GetMethodID(managerClass, "onClusterAttributeReadIntoRequest", "(IIILjava/nio/ByteBuffer;I)I");
+    if (mOnAttributeReadDirectMethod == nullptr)
+    {
+        ChipLogError(Zcl, "Failed to access BridgeApp 'onClusterAttributeReadIntoRequest' method");
+        env->ExceptionClear();
+    }
+
+    mOnEndpointAttributesReadMethod = env->GetMethodID(managerClass, "onEndpointAttributesRead", "(I[I[I)[B");
+    if (mOnEndpointAttributesReadMethod == nullptr)
+    {
+        ChipLogError(Zcl, "Failed to access BridgeApp 'onEndpointAttributesRead' method");
+        env->ExceptionClear();
+    }
+
     mOnAttributeWriteMethod = env->GetMethodID(managerClass, "onClusterAttributeWriteRequest", "(III[B)Z");
     if (mOnAttributeWriteMethod == nullptr)
     {
@@ -830,12 +1116,52 @@ void BridgeAppJNI::InitializeWithObjects(jobject app)
         ChipLogError(Zcl, "Failed to access BridgeApp 'onClusterCommandRequest' method");
         env->ExceptionClear();
     }
+
+    // Device definitions are parsed on every addBridgedDevice(s) call, resolve their fields once
+    jclass attributeClass = env->FindClass("com/matter/bridge/app/ClusterAttribute");
+    if (attributeClass != nullptr && mClusterAttributeClass.Init(attributeClass) == CHIP_NO_ERROR)
+    {
+        mClusterAttributeFieldsResolved = ResolveFields(env, attributeClass,
+                                                        { { &mClusterAttributeFields.clusterId, "clusterId", "I" },
+                                                          { &mClusterAttributeFields.attributeId, "attributeId", "I" },
+                                                          { &mClusterAttributeFields.type, "type", "I" },
+                                                          { &mClusterAttributeFields.size, "size", "I" },
+                                                          { &mClusterAttributeFields.mask, "mask", "I" },
+                                                          { &mClusterAttributeFields.flags, "flags", "I" },
+                                                          { &mClusterAttributeFields.defaultValue, "defaultValue", "[B" } });
+    }
+    if (!mClusterAttributeFieldsResolved)
+    {
+        ChipLogError(Zcl, "Failed to access ClusterAttribute fields");
+        env->ExceptionClear();
+    }
+    env->DeleteLocalRef(attributeClass);
+
+    jclass specClass = env->FindClass("com/matter/bridge/app/DeviceSpec");
+    if (specClass != nullptr && mDeviceSpecClass.Init(specClass) == CHIP_NO_ERROR)
+    {
+        mDeviceSpecFieldsResolved =
+            ResolveFields(env, specClass,
+                          { { &mDeviceSpecFields.endpoint, "endpoint", "I" },
+                            { &mDeviceSpecFields.parentEndpointId, "parentEndpointId", "I" },
+                            { &mDeviceSpecFields.name, "name", "Ljava/lang/String;" },
+                            { &mDeviceSpecFields.templateId, "templateId", "I" },
+                            { &mDeviceSpecFields.clusterIds, "clusterIds", "[I" },
+                            { &mDeviceSpecFields.attributes, "attributes", "[Lcom/matter/bridge/app/ClusterAttribute;" },
+                            { &mDeviceSpecFields.deviceTypeIds, "deviceTypeIds", "[I" } });
+    }
+    if (!mDeviceSpecFieldsResolved)
+    {
+        ChipLogError(Zcl, "Failed to access DeviceSpec fields");
+        env->ExceptionClear();
+    }
+    env->DeleteLocalRef(specClass);
 }
 
 void BridgeAppJNI::PostClusterInit(int clusterId, int endpoint)
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
-    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "Failed to GetEnvForCurrentThread for BridgeAppJNI::PostClusterInit"));
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "Failed to get JNIEnv for BridgeAppJNI::PostClusterInit"));
     VerifyOrReturn(mDeviceAppObject.HasValidObjectRef(), ChipLogError(Zcl, "BridgeAppJNI::mDeviceAppObject null"));
     VerifyOrReturn(mPostClusterInitMethod != nullptr, ChipLogError(Zcl, "BridgeAppJNI::mPostClusterInitMethod null"));
 
@@ -850,8 +1176,8 @@ void BridgeAppJNI::PostClusterInit(int clusterId, int endpoint)
 
 void BridgeAppJNI::PostEvent(int event)
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
-    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "Failed to GetEnvForCurrentThread for BridgeAppJNI::PostEvent"));
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "Failed to get JNIEnv for BridgeAppJNI::PostEvent"));
     VerifyOrReturn(mDeviceAppObject.HasValidObjectRef(), ChipLogError(Zcl, "BridgeAppJNI::mDeviceAppObject null"));
     VerifyOrReturn(mPostEventMethod != nullptr, ChipLogError(Zcl, "BridgeAppJNI::mPostEventMethod null"));
 
@@ -865,9 +1191,159 @@ void BridgeAppJNI::PostEvent(int event)
 
 void BridgeAppJNI::PostDeviceStateChanged(int endpoint, int clusterId, int attributeId, uint8_t* value, size_t valueSize)
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
-    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "PostDeviceStateChanged: Failed to GetEnvForCurrentThread"));
-    VerifyOrReturn(mDeviceAppObject.HasValidObjectRef(), ChipLogError(Zcl, "PostDeviceStateChanged: mDeviceAppObject null"));
+    StateChangeBatcher::GetInstance().Add(static_cast<chip::EndpointId>(endpoint), static_cast<chip::ClusterId>(clusterId),
+                                          static_cast<chip::AttributeId>(attributeId),
+                                          (value != nullptr) ? ByteSpan(value, valueSize) : ByteSpan());
+}
+
+void BridgeAppJNI::PostDeviceStateChangedBatch(const StateChangeBatcher::Batch & batch)
+{
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "PostDeviceStateChangedBatch: Failed to get JNIEnv"));
+    VerifyOrReturn(mDeviceAppObject.HasValidObjectRef(), ChipLogError(Zcl, "PostDeviceStateChangedBatch: mDeviceAppObject null"));
+
+    if (mPostDeviceStateChangedBatchMethod == nullptr)
+    {
+        for (size_t i = 0; i < batch.Size(); i++)
+        {
+            PostDeviceStateChangedSingle(env, batch.endpoints[i], batch.clusterIds[i], batch.attributeIds[i],
+                                         batch.values.data() + batch.offsets[i],
+                                         static_cast<size_t>(batch.offsets[i + 1] - batch.offsets[i]));
+        }
+        return;
+    }
+
+    jsize count          = static_cast<jsize>(batch.Size());
+    jintArray endpoints  = env->NewIntArray(count);
+    jintArray clusterIds = env->NewIntArray(count);
+    jintArray attributes = env->NewIntArray(count);
+    jintArray offsets    = env->NewIntArray(count + 1);
+    jbyteArray values    = env->NewByteArray(static_cast<jsize>(batch.values.size()));
+    if (endpoints != nullptr && clusterIds != nullptr && attributes != nullptr && offsets != nullptr && values != nullptr)
+    {
+        env->SetIntArrayRegion(endpoints, 0, count, batch.endpoints.data());
+        env->SetIntArrayRegion(clusterIds, 0, count, batch.clusterIds.data());
+        env->SetIntArrayRegion(attributes, 0, count, batch.attributeIds.data());
+        env->SetIntArrayRegion(offsets, 0, count + 1, batch.offsets.data());
+        env->SetByteArrayRegion(values, 0, static_cast<jsize>(batch.values.size()),
+                                reinterpret_cast<const jbyte *>(batch.values.data()));
+
+        env->CallVoidMethod(mDeviceAppObject.ObjectRef(), mPostDeviceStateChangedBatchMethod, endpoints, clusterIds, attributes,
+                            values, offsets);
+        if (env->ExceptionCheck())
+        {
+            ChipLogError(Zcl, "PostDeviceStateChangedBatch: Failed to call 'postDeviceStateChangedBatch' method");
+            env->ExceptionClear();
+        }
+    }
+    else
+    {
+        ChipLogError(Zcl, "PostDeviceStateChangedBatch: Failed to create Java arrays");
+        env->ExceptionClear();
+    }
+
+    env->DeleteLocalRef(endpoints);
+    env->DeleteLocalRef(clusterIds);
+    env->DeleteLocalRef(attributes);
+    env->DeleteLocalRef(offsets);
+    env->DeleteLocalRef(values);
+}
+
+void BridgeAppJNI::PostBridgedDevicesAdded(jint requestId, const std::vector<jint> & endpoints, uint64_t elapsedUs)
+{
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "PostBridgedDevicesAdded: Failed to get JNIEnv"));
+    VerifyOrReturn(mDeviceAppObject.HasValidObjectRef(), ChipLogError(Zcl, "PostBridgedDevicesAdded: mDeviceAppObject null"));
+    VerifyOrReturn(mPostBridgedDevicesAddedMethod != nullptr,
+                   ChipLogError(Zcl, "PostBridgedDevicesAdded: mPostBridgedDevicesAddedMethod null"));
+
+    jsize count             = static_cast<jsize>(endpoints.size());
+    jintArray endpointArray = env->NewIntArray(count);
+    if (endpointArray == nullptr)
+    {
+        ChipLogError(Zcl, "PostBridgedDevicesAdded: Failed to create Java array");
+        env->ExceptionClear();
+        return;
+    }
+    env->SetIntArrayRegion(endpointArray, 0, count, endpoints.data());
+
+    env->CallVoidMethod(mDeviceAppObject.ObjectRef(), mPostBridgedDevicesAddedMethod, requestId, endpointArray,
+                        static_cast<jlong>(elapsedUs));
+    if (env->ExceptionCheck())
+    {
+        ChipLogError(Zcl, "PostBridgedDevicesAdded: Failed to call 'postBridgedDevicesAdded' method");
+        env->ExceptionClear();
+    }
+    env->DeleteLocalRef(endpointArray);
+}
+
+void BridgeAppJNI::PostBridgedDevicesRestored(const std::vector<RestoredDevice> & devices, uint64_t elapsedUs)
+{
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "PostBridgedDevicesRestored: Failed to get JNIEnv"));
+    VerifyOrReturn(mDeviceAppObject.HasValidObjectRef(),
+                   ChipLogError(Zcl, "PostBridgedDevicesRestored: mDeviceAppObject null"));
+    VerifyOrReturn(mPostBridgedDevicesRestoredMethod != nullptr,
+                   ChipLogError(Zcl, "PostBridgedDevicesRestored: mPostBridgedDevicesRestoredMethod null"));
+
+    jsize count = static_cast<jsize>(devices.size());
+    // the arrays, plus a name and two ID arrays per device
+    VerifyOrReturn(env->PushLocalFrame(3 * count + 8) == JNI_OK, env->ExceptionClear();
+                   ChipLogError(Zcl, "PostBridgedDevicesRestored: Failed to reserve local references"));
+
+    jintArray endpointArray      = env->NewIntArray(count);
+    jintArray parentArray        = env->NewIntArray(count);
+    jclass stringClass           = env->FindClass("java/lang/String");
+    jclass intArrayClass         = env->FindClass("[I");
+    jobjectArray nameArray       = (stringClass != nullptr) ? env->NewObjectArray(count, stringClass, nullptr) : nullptr;
+    jobjectArray deviceTypeArray = (intArrayClass != nullptr) ? env->NewObjectArray(count, intArrayClass, nullptr) : nullptr;
+    jobjectArray clusterArray    = (intArrayClass != nullptr) ? env->NewObjectArray(count, intArrayClass, nullptr) : nullptr;
+    bool ok = endpointArray != nullptr && parentArray != nullptr && nameArray != nullptr && deviceTypeArray != nullptr &&
+        clusterArray != nullptr;
+
+    for (jsize i = 0; ok && i < count; i++)
+    {
+        const RestoredDevice & device = devices[static_cast<size_t>(i)];
+        jint endpoint                 = device.endpoint;
+        jint parent                   = device.parentEndpoint;
+        env->SetIntArrayRegion(endpointArray, i, 1, &endpoint);
+        env->SetIntArrayRegion(parentArray, i, 1, &parent);
+
+        jstring name          = env->NewStringUTF(device.name.c_str());
+        jintArray deviceTypes = env->NewIntArray(static_cast<jsize>(device.deviceTypeIds.size()));
+        jintArray clusters    = env->NewIntArray(static_cast<jsize>(device.clusterIds.size()));
+        ok = name != nullptr && deviceTypes != nullptr && clusters != nullptr;
+        if (ok)
+        {
+            env->SetIntArrayRegion(deviceTypes, 0, static_cast<jsize>(device.deviceTypeIds.size()), device.deviceTypeIds.data());
+            env->SetIntArrayRegion(clusters, 0, static_cast<jsize>(device.clusterIds.size()), device.clusterIds.data());
+            env->SetObjectArrayElement(nameArray, i, name);
+            env->SetObjectArrayElement(deviceTypeArray, i, deviceTypes);
+            env->SetObjectArrayElement(clusterArray, i, clusters);
+        }
+    }
+
+    if (!ok)
+    {
+        ChipLogError(Zcl, "PostBridgedDevicesRestored: Failed to create Java arrays");
+        env->ExceptionClear();
+        env->PopLocalFrame(nullptr);
+        return;
+    }
+
+    env->CallVoidMethod(mDeviceAppObject.ObjectRef(), mPostBridgedDevicesRestoredMethod, endpointArray, parentArray, nameArray,
+                        deviceTypeArray, clusterArray, static_cast<jlong>(elapsedUs));
+    if (env->ExceptionCheck())
+    {
+        ChipLogError(Zcl, "PostBridgedDevicesRestored: Failed to call 'postBridgedDevicesRestored' method");
+        env->ExceptionClear();
+    }
+    env->PopLocalFrame(nullptr);
+}
+
+void BridgeAppJNI::PostDeviceStateChangedSingle(JNIEnv * env, int endpoint, int clusterId, int attributeId,
+                                                const uint8_t * value, size_t valueSize)
+{
     VerifyOrReturn(mPostDeviceStateChangedMethod != nullptr, ChipLogError(Zcl, "PostDeviceStateChanged: mPostDeviceStateChangedMethod null"));
 
     // Convert buffer to Java byte array
@@ -904,13 +1380,13 @@ void BridgeAppJNI::PostDeviceStateChanged(int endpoint, int clusterId, int attri
 
 chip::JniByteArray BridgeAppJNI::HandleClusterAttributeRead(int endpoint, int clusterId, int attributeId, int maxReadLength)
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
+    JNIEnv * env = JniEnvCache::GetEnv();
     
     // Create an empty JniByteArray for error returns
     // We'll only create a real JniByteArray if Java returns a valid result
     if (env == nullptr)
     {
-        ChipLogError(Zcl, "HandleClusterAttributeRead: Failed to GetEnvForCurrentThread");
+        ChipLogError(Zcl, "HandleClusterAttributeRead: Failed to get JNIEnv");
         return chip::JniByteArray(env, nullptr);
     }
     
@@ -949,24 +1425,166 @@ chip::JniByteArray BridgeAppJNI::HandleClusterAttributeRead(int endpoint, int cl
     }
 }
 
-bool BridgeAppJNI::HandleClusterAttributeWrite(int endpoint, int clusterId, int attributeId, uint8_t* buffer, size_t bufferSize)
+namespace {
+
+// Direct ByteBuffer over native memory, created once per upcall thread and reused for every direct read
+struct ThreadReadBuffer
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
-    VerifyOrReturnValue(env != nullptr, false, ChipLogError(Zcl, "HandleClusterAttributeWrite: Failed to GetEnvForCurrentThread"));
-    VerifyOrReturnValue(mDeviceAppObject.HasValidObjectRef(), false, ChipLogError(Zcl, "HandleClusterAttributeWrite: mDeviceAppObject null"));
-    VerifyOrReturnValue(mOnAttributeWriteMethod != nullptr, false, ChipLogError(Zcl, "HandleClusterAttributeWrite: mOnAttributeWriteMethod null"));
+    uint8_t data[BridgeAppJNI::kReadBufferSize];
+    jobject buffer = nullptr;
 
-    // Convert buffer to Java byte array
-    jbyteArray javaBuffer = env->NewByteArray(static_cast<jsize>(bufferSize));
-    if (javaBuffer == nullptr)
+    // Runs at thread exit. Threads JniEnvCache attached are still attached here (its detach hook runs later), but
+    // ART has already unregistered Java-created threads, leaving any cached JNIEnv dangling: ask the VM instead of
+    // the cache, and leak the reference of a detached thread rather than touch the VM from it.
+    ~ThreadReadBuffer()
     {
-        ChipLogError(Zcl, "HandleClusterAttributeWrite: Failed to create Java byte array");
-        return false;
+        JavaVM * vm  = JniReferences::GetInstance().GetJavaVm();
+        JNIEnv * env = nullptr;
+        if (buffer != nullptr && vm != nullptr && vm->GetEnv(reinterpret_cast<void **>(&env), JNI_VERSION_1_6) == JNI_OK)
+        {
+            env->DeleteGlobalRef(buffer);
+        }
     }
-    
-    env->SetByteArrayRegion(javaBuffer, 0, static_cast<jsize>(bufferSize), reinterpret_cast<const jbyte*>(buffer));
-    
-    jboolean result = env->CallBooleanMethod(
+};
+
+thread_local std::unique_ptr<ThreadReadBuffer> tReadBuffer;
+
+ThreadReadBuffer * GetThreadReadBuffer(JNIEnv * env)
+{
+    if (tReadBuffer)
+    {
+        return tReadBuffer.get();
+    }
+
+    std::unique_ptr<ThreadReadBuffer> readBuffer(new ThreadReadBuffer());
+    jobject localBuffer = env->NewDirectByteBuffer(readBuffer->data, sizeof(readBuffer->data));
+    VerifyOrReturnValue(localBuffer != nullptr, nullptr, env->ExceptionClear());
+    readBuffer->buffer = env->NewGlobalRef(localBuffer);
+    env->DeleteLocalRef(localBuffer);
+    VerifyOrReturnValue(readBuffer->buffer != nullptr, nullptr);
+
+    tReadBuffer = std::move(readBuffer);
+    return tReadBuffer.get();
+}
+
+} // anonymous namespace
+
+int BridgeAppJNI::HandleClusterAttributeReadDirect(int endpoint, int clusterId, int attributeId, uint8_t * buffer,
+                                                   uint16_t maxReadLength)
+{
+    VerifyOrReturnValue(maxReadLength <= kReadBufferSize, kReadFailed);
+    VerifyOrReturnValue(mOnAttributeReadDirectMethod != nullptr, kReadFailed);
+    VerifyOrReturnValue(mDeviceAppObject.HasValidObjectRef(), kReadFailed,
+                        ChipLogError(Zcl, "HandleClusterAttributeReadDirect: mDeviceAppObject null"));
+
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturnValue(env != nullptr, kReadFailed, ChipLogError(Zcl, "HandleClusterAttributeReadDirect: Failed to get JNIEnv"));
+
+    ThreadReadBuffer * readBuffer = GetThreadReadBuffer(env);
+    VerifyOrReturnValue(readBuffer != nullptr, kReadFailed,
+                        ChipLogError(Zcl, "HandleClusterAttributeReadDirect: Failed to create direct buffer"));
+
+    jint length = env->CallIntMethod(mDeviceAppObject.ObjectRef(), mOnAttributeReadDirectMethod, static_cast<jint>(endpoint),
+                                     static_cast<jint>(clusterId), static_cast<jint>(attributeId), readBuffer->buffer,
+                                     static_cast<jint>(maxReadLength));
+    if (env->ExceptionCheck())
+    {
+        ChipLogError(Zcl, "HandleClusterAttributeReadDirect: Exception calling onClusterAttributeReadIntoRequest");
+        env->ExceptionClear();
+        return kReadFailed;
+    }
+    // BridgeAppCallback.READ_UNHANDLED, READ_TOO_LARGE and READ_UNAVAILABLE
+    VerifyOrReturnValue(length != -1, kReadUnhandled);
+    VerifyOrReturnValue(length != -2, kReadTooLarge);
+    VerifyOrReturnValue(length >= 0, kReadUnavailable);
+    VerifyOrReturnValue(length <= maxReadLength, kReadTooLarge);
+
+    memcpy(buffer, readBuffer->data, static_cast<size_t>(length));
+    return length;
+}
+
+int BridgeAppJNI::ReadClusterAttribute(int endpoint, int clusterId, int attributeId, uint8_t * buffer, uint16_t maxReadLength)
+{
+    if (mOnAttributeReadDirectMethod != nullptr && maxReadLength <= kReadBufferSize)
+    {
+        return HandleClusterAttributeReadDirect(endpoint, clusterId, attributeId, buffer, maxReadLength);
+    }
+
+    auto result = HandleClusterAttributeRead(endpoint, clusterId, attributeId, maxReadLength);
+    VerifyOrReturnValue(result.data() != nullptr, kReadUnavailable);
+    VerifyOrReturnValue(result.size() <= maxReadLength, kReadTooLarge);
+
+    memcpy(buffer, result.data(), static_cast<size_t>(result.size()));
+    return static_cast<int>(result.size());
+}
+
+bool BridgeAppJNI::HandleEndpointAttributesRead(int endpoint, const std::vector<chip::app::ConcreteAttributePath> & paths,
+                                                std::vector<uint8_t> & packed)
+{
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturnValue(env != nullptr, false, ChipLogError(Zcl, "HandleEndpointAttributesRead: Failed to get JNIEnv"));
+    VerifyOrReturnValue(mDeviceAppObject.HasValidObjectRef(), false, ChipLogError(Zcl, "HandleEndpointAttributesRead: mDeviceAppObject null"));
+    VerifyOrReturnValue(mOnEndpointAttributesReadMethod != nullptr, false);
+
+    jsize count = static_cast<jsize>(paths.size());
+    std::vector<jint> clusterIds(paths.size());
+    std::vector<jint> attributeIds(paths.size());
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        clusterIds[i]   = static_cast<jint>(paths[i].mClusterId);
+        attributeIds[i] = static_cast<jint>(paths[i].mAttributeId);
+    }
+
+    jintArray javaClusterIds   = env->NewIntArray(count);
+    jintArray javaAttributeIds = env->NewIntArray(count);
+    if (javaClusterIds == nullptr || javaAttributeIds == nullptr)
+    {
+        ChipLogError(Zcl, "HandleEndpointAttributesRead: Failed to create Java int arrays");
+        env->ExceptionClear();
+        return false;
+    }
+    env->SetIntArrayRegion(javaClusterIds, 0, count, clusterIds.data());
+    env->SetIntArrayRegion(javaAttributeIds, 0, count, attributeIds.data());
+
+    jbyteArray javaResult = static_cast<jbyteArray>(env->CallObjectMethod(
+        mDeviceAppObject.ObjectRef(), mOnEndpointAttributesReadMethod, static_cast<jint>(endpoint), javaClusterIds, javaAttributeIds));
+
+    env->DeleteLocalRef(javaClusterIds);
+    env->DeleteLocalRef(javaAttributeIds);
+
+    if (env->ExceptionCheck())
+    {
+        ChipLogError(Zcl, "HandleEndpointAttributesRead: Exception calling onEndpointAttributesRead");
+        env->ExceptionClear();
+        return false;
+    }
+    VerifyOrReturnValue(javaResult != nullptr, false);
+
+    jsize resultLen = env->GetArrayLength(javaResult);
+    packed.resize(static_cast<size_t>(resultLen));
+    env->GetByteArrayRegion(javaResult, 0, resultLen, reinterpret_cast<jbyte *>(packed.data()));
+    env->DeleteLocalRef(javaResult);
+    return true;
+}
+
+bool BridgeAppJNI::HandleClusterAttributeWrite(int endpoint, int clusterId, int attributeId, uint8_t* buffer, size_t bufferSize)
+{
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturnValue(env != nullptr, false, ChipLogError(Zcl, "HandleClusterAttributeWrite: Failed to get JNIEnv"));
+    VerifyOrReturnValue(mDeviceAppObject.HasValidObjectRef(), false, ChipLogError(Zcl, "HandleClusterAttributeWrite: mDeviceAppObject null"));
+    VerifyOrReturnValue(mOnAttributeWriteMethod != nullptr, false, ChipLogError(Zcl, "HandleClusterAttributeWrite: mOnAttributeWriteMethod null"));
+
+    // Convert buffer to Java byte array
+    jbyteArray javaBuffer = env->NewByteArray(static_cast<jsize>(bufferSize));
+    if (javaBuffer == nullptr)
+    {
+        ChipLogError(Zcl, "HandleClusterAttributeWrite: Failed to create Java byte array");
+        return false;
+    }
+    
+    env->SetByteArrayRegion(javaBuffer, 0, static_cast<jsize>(bufferSize), reinterpret_cast<const jbyte*>(buffer));
+    
+    jboolean result = env->CallBooleanMethod(
         mDeviceAppObject.ObjectRef(), mOnAttributeWriteMethod,
         static_cast<jint>(endpoint), static_cast<jint>(clusterId),
         static_cast<jint>(attributeId), javaBuffer);
@@ -985,8 +1603,8 @@ bool BridgeAppJNI::HandleClusterAttributeWrite(int endpoint, int clusterId, int
 
 bool BridgeAppJNI::HandleCommand(int endpoint, int clusterId, int commandId)
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
-    VerifyOrReturnValue(env != nullptr, false, ChipLogError(Zcl, "HandleCommand: Failed to GetEnvForCurrentThread"));
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturnValue(env != nullptr, false, ChipLogError(Zcl, "HandleCommand: Failed to get JNIEnv"));
     VerifyOrReturnValue(mDeviceAppObject.HasValidObjectRef(), false, ChipLogError(Zcl, "HandleCommand: mDeviceAppObject null"));
     VerifyOrReturnValue(mOnCommandMethod != nullptr, false, ChipLogError(Zcl, "HandleCommand: mOnCommandMethod null"));
 
@@ -1015,6 +1633,7 @@ void BridgeAppJNI::ReportAttributeChange(int endpoint, int clusterId, int attrib
         static_cast<chip::ClusterId>(clusterId),
         static_cast<chip::AttributeId>(attributeId)
     );
+    RegistrySnapshot::GetInstance().MarkValuesChanged();
 }
 
 namespace {
@@ -1030,28 +1649,31 @@ public:
     {
         const ConcreteCommandPath & commandPath = handlerContext.mRequestPath;
         
+        LatencyTracer::TraceId trace =
+            LatencyTracer::GetInstance().Begin(commandPath.mEndpointId, commandPath.mClusterId, /* isCommand */ true);
+
         // Signal that we are handling this command
         handlerContext.SetCommandHandled();
         
         // Forward to Java/Kotlin
+        LatencyTracer::GetInstance().Mark(trace, LatencyTracer::Stage::kJniEnter);
         bool handled = BridgeAppJNIMgr().HandleCommand(
             static_cast<int>(commandPath.mEndpointId),
             static_cast<int>(commandPath.mClusterId),
             static_cast<int>(commandPath.mCommandId)
         );
+        LatencyTracer::GetInstance().Mark(trace, LatencyTracer::Stage::kJniExit);
         
         if (handled)
         {
+            // Kotlin pushes the attributes the command changed from its callback, so the native values stay current
             handlerContext.mCommandHandler.AddStatus(commandPath, Protocols::InteractionModel::Status::Success);
-            
-            // Report OnOff attribute change after successful command execution
+
+            // Report OnOff attribute change after successful command execution; queued so it merges with the
+            // report of the update Kotlin usually pushes from the command callback
             if (commandPath.mClusterId == OnOff::Id)
             {
-                MatterReportingAttributeChangeCallback(
-                    commandPath.mEndpointId,
-                    OnOff::Id,
-                    OnOff::Attributes::OnOff::Id
-                );
+                ScheduleReportingCallback(commandPath.mEndpointId, OnOff::Id, OnOff::Attributes::OnOff::Id);
             }
         }
         else
@@ -1065,13 +1687,19 @@ BridgeDeviceCommandHandler gBridgeDeviceCommandHandler;
 
 } // namespace
 
+static jint RegisterBridgeAppNatives(JavaVM * jvm);
+
 jint JNI_OnLoad(JavaVM * jvm, void * reserved)
 {
-    return AndroidAppServerJNI_OnLoad(jvm, reserved);
+    jint version = AndroidAppServerJNI_OnLoad(jvm, reserved);
+    VerifyOrReturnValue(version != JNI_ERR, version);
+    ConfigureDefaultReportingThresholds();
+    return RegisterBridgeAppNatives(jvm) == JNI_OK ? version : JNI_ERR;
 }
 
 void JNI_OnUnload(JavaVM * jvm, void * reserved)
 {
+    WriteBehindQueue::GetInstance().Shutdown();
     return AndroidAppServerJNI_OnUnload(jvm, reserved);
 }
 
@@ -1098,6 +1726,9 @@ JNI_METHOD(void, postServerInit)(JNIEnv *, jobject, jint deviceTypeId)
     // Register command handler
     chip::app::CommandHandlerInterfaceRegistry::Instance().RegisterCommandHandler(&gBridgeDeviceCommandHandler);
     
+    // Devices of the registry snapshot are built here, the Matter thread only publishes them
+    PrepareRegistrySnapshot();
+
     // Use ScheduleWork to run on the Matter thread
     ChipLogProgress(Zcl, "postServerInit() calling ScheduleWork");
     CHIP_ERROR err = chip::DeviceLayer::PlatformMgr().ScheduleWork(
@@ -1105,9 +1736,11 @@ JNI_METHOD(void, postServerInit)(JNIEnv *, jobject, jint deviceTypeId)
             // Initialize endpoint tracking
             gFirstDynamicEndpointId = static_cast<chip::EndpointId>(
                 static_cast<int>(emberAfEndpointFromIndex(static_cast<uint16_t>(emberAfFixedEndpointCount() - 1))) + 1);
-            gCurrentEndpointId = gFirstDynamicEndpointId;
+            EndpointAllocator::GetInstance().Init(gFirstDynamicEndpointId);
             
             ChipLogProgress(Zcl, "postServerInit() completed - first dynamic endpoint ID: %d", gFirstDynamicEndpointId);
+
+            PublishRegistrySnapshot();
         },
         0);
     ChipLogProgress(Zcl, "postServerInit() ScheduleWork returned");
@@ -1115,6 +1748,7 @@ JNI_METHOD(void, postServerInit)(JNIEnv *, jobject, jint deviceTypeId)
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Zcl, "Failed to schedule postServerInit work: %" CHIP_ERROR_FORMAT, err.Format());
+        DiscardRegistrySnapshot();
     }
     else
     {
@@ -1169,28 +1803,17 @@ JNI_METHOD(jboolean, removeBridgedDevice)(JNIEnv *, jobject, jint endpoint)
     
     chip::DeviceLayer::StackLock lock;  // Thread-safe access to gDevices
     
-    // Find the device with matching endpoint ID
-    // We need to search through gDevices because endpoint ID != array index
-    Device * deviceToRemove = nullptr;
-    int deviceIndex = -1;
-    
-    for (int i = 0; i < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT; i++)
-    {
-        if (gDevices[i] != nullptr && gDevices[i]->GetEndpointId() == static_cast<EndpointId>(endpoint))
-        {
-            deviceToRemove = gDevices[i];
-            deviceIndex = i;
-            ChipLogProgress(Zcl, "Found device '%s' at endpoint %d, index %d", 
-                           gDevices[i]->GetName(), endpoint, i);
-            break;
-        }
-    }
+    // Endpoint ID != array index, the endpoint table maps one to the other
+    EndpointTable::Entry entry = EndpointTable::GetInstance().Find(static_cast<EndpointId>(endpoint));
+    Device * deviceToRemove    = entry.device;
+    int deviceIndex            = entry.slot;
     
     if (deviceToRemove == nullptr)
     {
         ChipLogError(Zcl, "Device not found with endpoint %d", endpoint);
         return JNI_FALSE;
     }
+    ChipLogProgress(Zcl, "Found device '%s' at endpoint %d, index %d", deviceToRemove->GetName(), endpoint, deviceIndex);
     
     // Create context for ScheduleWork
     struct RemoveDeviceContext {
@@ -1212,8 +1835,15 @@ JNI_METHOD(jboolean, removeBridgedDevice)(JNIEnv *, jobject, jint endpoint)
                 ChipLogProgress(Zcl, "Successfully removed device at index %d", ret);
                 // RemoveDeviceEndpoint already set gDevices[ret] = nullptr
                 
-                // Clear device type
-                gDeviceTypes[ret] = DeviceType::Unknown;
+                // Remembered while the values are still stored, for when the device comes back at this endpoint
+                if (gEndpointMetadata[ret])
+                {
+                    DataVersionStore::GetInstance().Remember(ctx->device->GetEndpointId(), *gEndpointMetadata[ret]->endpointTemplate,
+                                                             gEndpointMetadata[ret]->dataVersions);
+                }
+                AttributeStore::GetInstance().RemoveEndpoint(ctx->device->GetEndpointId());
+                WriteBehindQueue::GetInstance().Forget(ctx->device->GetEndpointId());
+                ReportThrottle::GetInstance().RemoveEndpoint(ctx->device->GetEndpointId());
                 
                 // Only delete if this was a dynamically allocated device
                 if (gDynamicDevices[ret])
@@ -1221,6 +1851,8 @@ JNI_METHOD(jboolean, removeBridgedDevice)(JNIEnv *, jobject, jint endpoint)
                     delete ctx->device;
                     gDynamicDevices[ret] = false;
                 }
+                gEndpointMetadata[ret].reset();
+                RegistrySnapshot::GetInstance().MarkDirty();
             }
             else
             {
@@ -1237,74 +1869,126 @@ JNI_METHOD(jboolean, removeBridgedDevice)(JNIEnv *, jobject, jint endpoint)
 #define DEVICE_VERSION_DEFAULT 1
 
 // Generic Device Support JNI Methods
-JNI_METHOD(jboolean, addBridgedDevice)(JNIEnv * env, jobject, jint endpoint, jint parentEndpointId, jstring name, jintArray clusterIds, jobjectArray attributes, jintArray deviceTypeIds)
+namespace {
+
+// Device definition as passed from Kotlin
+struct DeviceSchema
 {
-    const char * deviceName = env->GetStringUTFChars(name, nullptr);
-    jsize clusterCount = env->GetArrayLength(clusterIds);
-    jint * clusters = env->GetIntArrayElements(clusterIds, nullptr);
-    
-    std::vector<chip::ClusterId> requestedClusters;
-    for(int i=0; i<clusterCount; i++) {
-        requestedClusters.push_back(static_cast<chip::ClusterId>(clusters[i]));
+    std::vector<chip::ClusterId> clusters;
+    // Map<ClusterId, vector<EmberAfAttributeMetadata>>
+    std::map<chip::ClusterId, std::vector<EmberAfAttributeMetadata>> clusterAttributes;
+    // Layout of the native value store for this endpoint
+    std::vector<AttributeStore::AttributeDesc> storeAttributes;
+    std::vector<EmberAfDeviceType> deviceTypes;
+};
+
+void ReadSchemaIds(JNIEnv * env, jintArray clusterIds, jintArray deviceTypeIds, DeviceSchema & schema)
+{
+    if (clusterIds != nullptr) {
+        jsize clusterCount = env->GetArrayLength(clusterIds);
+        jint * clusters = env->GetIntArrayElements(clusterIds, nullptr);
+        for(int i=0; i<clusterCount; i++) {
+            schema.clusters.push_back(static_cast<chip::ClusterId>(clusters[i]));
+        }
+        env->ReleaseIntArrayElements(clusterIds, clusters, JNI_ABORT);
     }
-    
-    env->ReleaseIntArrayElements(clusterIds, clusters, 0);
 
     // Parse Device Type IDs
-    std::vector<EmberAfDeviceType> requestedDeviceTypes;
     if (deviceTypeIds != nullptr) {
         jsize dtCount = env->GetArrayLength(deviceTypeIds);
         jint * dtIds = env->GetIntArrayElements(deviceTypeIds, nullptr);
         for(int i=0; i<dtCount; i++) {
-            requestedDeviceTypes.push_back(EmberAfDeviceType{
+            schema.deviceTypes.push_back(EmberAfDeviceType{
                 static_cast<uint32_t>(dtIds[i]),
                 static_cast<uint8_t>(DEVICE_VERSION_DEFAULT)
             });
         }
-        env->ReleaseIntArrayElements(deviceTypeIds, dtIds, 0);
+        env->ReleaseIntArrayElements(deviceTypeIds, dtIds, JNI_ABORT);
     }
-    
-    DeviceGeneric * newDevice = new DeviceGeneric(deviceName, "Generic");
-    env->ReleaseStringUTFChars(name, deviceName);
-    
-    // Create Dynamic Endpoint Data
-    DynamicEndpointData* epData = new DynamicEndpointData();
-    
-    // Parse Attributes and group by Cluster
-    // Map<ClusterId, vector<EmberAfAttributeMetadata>>
-    std::map<chip::ClusterId, std::vector<EmberAfAttributeMetadata>> clusterAttributes;
-    
+}
+
+// Adds one attribute to the ember metadata of its cluster and to the native store layout
+void AddSchemaAttribute(DeviceSchema & schema, jint clusterId, jint attributeId, jint type, jint size, jint mask, jint flags,
+                        std::vector<uint8_t> defaultValue)
+{
+    EmberAfAttributeMetadata metadata = {
+        .defaultValue = ZAP_EMPTY_DEFAULT(),
+        .attributeId = static_cast<chip::AttributeId>(attributeId),
+        .size = static_cast<uint16_t>(size),
+        .attributeType = static_cast<EmberAfAttributeType>(type),
+        .mask = static_cast<EmberAfAttributeMask>(mask)
+    };
+
+    schema.clusterAttributes[static_cast<chip::ClusterId>(clusterId)].push_back(metadata);
+    schema.storeAttributes.push_back(AttributeStore::AttributeDesc{ static_cast<chip::ClusterId>(clusterId), metadata.attributeId,
+                                                                    metadata.attributeType, metadata.size,
+                                                                    static_cast<uint8_t>(flags), std::move(defaultValue) });
+}
+
+void ReadDeviceSchema(JNIEnv * env, jintArray clusterIds, jobjectArray attributes, jintArray deviceTypeIds, DeviceSchema & schema)
+{
+    ReadSchemaIds(env, clusterIds, deviceTypeIds, schema);
+
+    // Parse Attributes and group by Cluster, with the field IDs resolved in BridgeAppJNI::InitializeWithObjects
     if (attributes != nullptr) {
+        const BridgeAppJNI::ClusterAttributeFields * fields = BridgeAppJNIMgr().GetClusterAttributeFields();
+        VerifyOrReturn(fields != nullptr, ChipLogError(Zcl, "ReadDeviceSchema: ClusterAttribute fields not resolved"));
+
         jsize attrCount = env->GetArrayLength(attributes);
-        jclass attrClass = env->FindClass("com/matter/bridge/app/ClusterAttribute");
-        jfieldID clusterIdField = env->GetFieldID(attrClass, "clusterId", "I");
-        jfieldID attributeIdField = env->GetFieldID(attrClass, "attributeId", "I");
-        jfieldID typeField = env->GetFieldID(attrClass, "type", "I");
-        jfieldID sizeField = env->GetFieldID(attrClass, "size", "I");
-        jfieldID maskField = env->GetFieldID(attrClass, "mask", "I");
-        
         for(int i=0; i<attrCount; i++) {
             jobject attrObj = env->GetObjectArrayElement(attributes, i);
-            
-            int cId = env->GetIntField(attrObj, clusterIdField);
-            int aId = env->GetIntField(attrObj, attributeIdField);
-            int type = env->GetIntField(attrObj, typeField);
-            int size = env->GetIntField(attrObj, sizeField);
-            int mask = env->GetIntField(attrObj, maskField);
-            
-            EmberAfAttributeMetadata metadata = {
-                .defaultValue = ZAP_EMPTY_DEFAULT(),
-                .attributeId = static_cast<chip::AttributeId>(aId),
-                .size = static_cast<uint16_t>(size),
-                .attributeType = static_cast<EmberAfAttributeType>(type),
-                .mask = static_cast<EmberAfAttributeMask>(mask)
-            };
-            
-            clusterAttributes[static_cast<chip::ClusterId>(cId)].push_back(metadata);
-            
+            if (attrObj == nullptr) {
+                continue;
+            }
+
+            std::vector<uint8_t> defaultBytes;
+            jbyteArray defaultValue = static_cast<jbyteArray>(env->GetObjectField(attrObj, fields->defaultValue));
+            if (defaultValue != nullptr) {
+                jsize defaultLen = env->GetArrayLength(defaultValue);
+                defaultBytes.resize(static_cast<size_t>(defaultLen));
+                env->GetByteArrayRegion(defaultValue, 0, defaultLen, reinterpret_cast<jbyte *>(defaultBytes.data()));
+                env->DeleteLocalRef(defaultValue);
+            }
+
+            AddSchemaAttribute(schema, env->GetIntField(attrObj, fields->clusterId), env->GetIntField(attrObj, fields->attributeId),
+                               env->GetIntField(attrObj, fields->type), env->GetIntField(attrObj, fields->size),
+                               env->GetIntField(attrObj, fields->mask), env->GetIntField(attrObj, fields->flags),
+                               std::move(defaultBytes));
             env->DeleteLocalRef(attrObj);
         }
     }
+}
+
+// Same as ReadDeviceSchema with the attributes given as packed (cluster, attribute, type, size, mask) tuples.
+// Returns false if the packed array is not a whole number of tuples.
+bool ReadPackedDeviceSchema(JNIEnv * env, jintArray clusterIds, jintArray packedAttributes, jintArray deviceTypeIds,
+                            DeviceSchema & schema)
+{
+    constexpr jsize kTupleSize = 5;
+
+    ReadSchemaIds(env, clusterIds, deviceTypeIds, schema);
+    VerifyOrReturnValue(packedAttributes != nullptr, true);
+
+    jsize length = env->GetArrayLength(packedAttributes);
+    VerifyOrReturnValue(length % kTupleSize == 0, false,
+                        ChipLogError(Zcl, "ReadPackedDeviceSchema: %d ints are not whole attribute tuples", static_cast<int>(length)));
+
+    // Only plain native code runs while the array is pinned
+    auto * packed = static_cast<const jint *>(env->GetPrimitiveArrayCritical(packedAttributes, nullptr));
+    VerifyOrReturnValue(packed != nullptr, false, ChipLogError(Zcl, "ReadPackedDeviceSchema: failed to pin attributes"));
+    for (const jint * tuple = packed; tuple < packed + length; tuple += kTupleSize)
+    {
+        AddSchemaAttribute(schema, tuple[0], tuple[1], tuple[2], tuple[3], tuple[4], 0, {});
+    }
+    env->ReleasePrimitiveArrayCritical(packedAttributes, const_cast<jint *>(packed), JNI_ABORT);
+    return true;
+}
+
+// Builds the normalized ember endpoint definition of a schema, to be interned by EndpointTemplateRegistry
+void BuildEndpointDefinition(DeviceSchema & schema, EndpointDefinition & definition)
+{
+    std::vector<chip::ClusterId> & requestedClusters = schema.clusters;
+    auto & clusterAttributes = schema.clusterAttributes;
 
     // Automatically add Descriptor cluster if not present
     bool hasDescriptor = false;
@@ -1333,7 +2017,7 @@ JNI_METHOD(jboolean, addBridgedDevice)(JNIEnv * env, jobject, jint endpoint, jin
     }
     
     bool isBridgedNode = false;
-    for (const auto& dt : requestedDeviceTypes) {
+    for (const auto& dt : schema.deviceTypes) {
         if (dt.deviceTypeId == DEVICE_TYPE_BRIDGED_NODE) {
             isBridgedNode = true;
             break;
@@ -1349,151 +2033,692 @@ JNI_METHOD(jboolean, addBridgedDevice)(JNIEnv * env, jobject, jint endpoint, jin
         clusterAttributes[BridgedDeviceBasicInformation::Id] = attrs;
     }
 
-    // Add requested clusters and their attributes
+    // Normalize, so that the same definition given in another order shares the template
+    std::sort(requestedClusters.begin(), requestedClusters.end());
+    requestedClusters.erase(std::unique(requestedClusters.begin(), requestedClusters.end()), requestedClusters.end());
+    std::stable_sort(schema.storeAttributes.begin(), schema.storeAttributes.end(),
+                     [](const AttributeStore::AttributeDesc & a, const AttributeStore::AttributeDesc & b) {
+                         return std::make_pair(a.clusterId, a.attributeId) < std::make_pair(b.clusterId, b.attributeId);
+                     });
+
+    // Add requested clusters and their attributes, as passed by Kotlin (including revision)
     for (auto clusterId : requestedClusters) {
-        // Add common attributes if not present? 
-        // For now, assume Kotlin passes all necessary attributes including revision.
-        // Or we can auto-add revision if missing.
-        // Let's just use what's passed.
-        
         std::vector<EmberAfAttributeMetadata>& attrs = clusterAttributes[clusterId];
-        epData->attributes.push_back(attrs);
+        std::stable_sort(attrs.begin(), attrs.end(), [](const EmberAfAttributeMetadata & a, const EmberAfAttributeMetadata & b) {
+            return a.attributeId < b.attributeId;
+        });
+        definition.attributes.push_back(attrs);
     }
     
-    // Build Cluster structs
-    for (size_t i=0; i<epData->attributes.size(); i++) {
+    // Build Cluster structs, attributes are linked when the template is laid out
+    for (size_t i=0; i<definition.attributes.size(); i++) {
         EmberAfCluster cluster;
         cluster.clusterId = requestedClusters[i];
-        cluster.attributes = epData->attributes[i].data();
-        cluster.attributeCount = static_cast<uint16_t>(epData->attributes[i].size());
+        cluster.attributes = nullptr;
+        cluster.attributeCount = 0;
         cluster.mask = ZAP_CLUSTER_MASK(SERVER);
         cluster.functions = nullptr;
         
-        // Set accepted command list based on cluster ID
-        if (cluster.clusterId == OnOff::Id) {
-            cluster.acceptedCommandList = onOffIncomingCommands;
-        } else {
-            cluster.acceptedCommandList = nullptr;
-        }
+        cluster.acceptedCommandList = AcceptedCommandsFor(cluster.clusterId);
         
         cluster.generatedCommandList = nullptr;
         cluster.eventList = nullptr;
         cluster.eventCount = 0;
         
-        epData->clusters.push_back(cluster);
+        definition.clusters.push_back(cluster);
     }
     
-    epData->endpointType.cluster = epData->clusters.data();
-    epData->endpointType.clusterCount = static_cast<uint8_t>(epData->clusters.size());
-    epData->endpointType.endpointSize = 0;
-    
-    epData->dataVersions = new DataVersion[epData->clusters.size()];
-    
-    // Store device types in a persistent way
-    epData->deviceTypes = requestedDeviceTypes;
-    
-    gDynamicEndpoints.push_back(epData);
-    
-    // Schedule work
-    struct AddGenericContext {
-        DeviceGeneric* device;
-        EmberAfEndpointType* epType;
-        DataVersion* dataVersions;
-        chip::EndpointId endpoint;
-        chip::EndpointId parentEndpoint;
-        std::vector<EmberAfDeviceType>* deviceTypes;
-    };
-    
-    AddGenericContext* ctx = new AddGenericContext{
-        newDevice, 
-        &epData->endpointType, 
-        epData->dataVersions, 
+    definition.deviceTypes = std::move(schema.deviceTypes);
+    definition.storeAttributes = std::move(schema.storeAttributes);
+}
+
+// Generic device fully prepared off the Matter thread (storage, values, unique ID), waiting to be
+// registered as a dynamic endpoint
+struct PendingGenericDevice
+{
+    std::unique_ptr<DeviceGeneric> device;
+    std::unique_ptr<DynamicEndpointMetadata> metadata;
+    chip::EndpointId endpoint;
+    chip::EndpointId parentEndpoint;
+    AttributeStore::StagingToken values = AttributeStore::kNoStaging; // installed once the endpoint is live
+    bool hasRememberedVersions = false;
+    DataVersionStore::Entry rememberedVersions; // DataVersions the endpoint had before, see DataVersionStore
+    std::vector<uint8_t> keptVersions;          // clusters that continue from their remembered version
+    uint64_t valuesGeneration = 0;              // of the staged values the kept versions were checked against
+};
+
+// Matter-thread time spent in PublishGenericDevice, see getPublishStats
+std::atomic<uint64_t> gPublishCount{ 0 };
+std::atomic<uint64_t> gPublishFailures{ 0 };
+std::atomic<uint64_t> gPublishTotalNs{ 0 };
+std::atomic<uint64_t> gPublishMaxNs{ 0 };
+
+// Phase one of adding a generic device, on any thread (the JNI caller or the WorkerPool). Takes over the device
+// reference on endpointTemplate, which is released if nullptr is returned (out of memory, endpoint already being
+// added). uniqueId may be null to generate one; values are the initial values restored from the registry snapshot.
+std::unique_ptr<PendingGenericDevice> PrepareGenericDevice(const EndpointTemplate * endpointTemplate, jint endpoint,
+                                                           jint parentEndpointId, const char * deviceName,
+                                                           const char * uniqueId                             = nullptr,
+                                                           const std::vector<RegistrySnapshot::Value> * values = nullptr)
+{
+    VerifyOrReturnValue(endpointTemplate != nullptr, nullptr);
+
+    std::unique_ptr<DynamicEndpointMetadata> metadata(new DynamicEndpointMetadata());
+    size_t clusterCount = endpointTemplate->endpointType.clusterCount;
+    metadata->arena.Reserve<DataVersion>(clusterCount);
+    if (!metadata->arena.Init()) {
+        ChipLogError(Zcl, "addBridgedDevice: out of memory");
+        EndpointTemplateRegistry::GetInstance().Release(endpointTemplate);
+        return nullptr;
+    }
+    // the metadata holds the reference from here on, also on the failure paths below
+    metadata->endpointTemplate = endpointTemplate;
+    metadata->dataVersions = metadata->arena.Allocate<DataVersion>(clusterCount);
+    DataVersionStore::Seed(metadata->dataVersions, clusterCount);
+
+    std::unique_ptr<PendingGenericDevice> pending(new PendingGenericDevice{
+        std::unique_ptr<DeviceGeneric>(new DeviceGeneric(deviceName, "Generic")),
+        std::move(metadata),
         static_cast<chip::EndpointId>(endpoint),
-        static_cast<chip::EndpointId>(parentEndpointId),
-        &epData->deviceTypes
-    };
-    
-    ChipLogProgress(Zcl, "addBridgedDevice: endpoint=%d, parentEndpoint=%d, name=%s, clusterCount=%zu, deviceTypeCount=%zu", 
-                    endpoint, parentEndpointId, deviceName, requestedClusters.size(), requestedDeviceTypes.size());
-    
-    chip::DeviceLayer::PlatformMgr().ScheduleWork(
-        [](intptr_t arg) {
-            AddGenericContext* ctx = reinterpret_cast<AddGenericContext*>(arg);
-            
-            ChipLogProgress(Zcl, "addBridgedDevice: ScheduleWork lambda executing for endpoint %d", ctx->endpoint);
-            
-            ChipLogProgress(Zcl, "addBridgedDevice: Calling AddDeviceEndpoint for endpoint %d", ctx->endpoint);
-            
-            // Register endpoint with Matter SDK using AddDeviceEndpoint
-            int index = AddDeviceEndpoint(
-                ctx->device,
-                ctx->epType,
-                Span<const EmberAfDeviceType>(ctx->deviceTypes->data(), ctx->deviceTypes->size()),
-                Span<DataVersion>(ctx->dataVersions, ctx->epType->clusterCount),
-                ctx->endpoint,
-                #if CHIP_CONFIG_USE_ENDPOINT_UNIQUE_ID
-                Span<const char>(), // Empty unique ID for now
-                #endif
-                ctx->parentEndpoint
-            );
-            
-            if (index >= 0) {
-                // gDevices[index] is already set by AddDeviceEndpoint
-                gDeviceTypes[index] = DeviceType::Generic;
-                gDynamicDevices[index] = true;
-                ChipLogProgress(Zcl, "Successfully added generic device '%s' at endpoint %d, index %d", 
-                               ctx->device->GetName(), ctx->endpoint, index);
-            } else {
-                ChipLogError(Zcl, "Failed to add generic device at endpoint %d", ctx->endpoint);
-                delete ctx->device;
+        static_cast<chip::EndpointId>(parentEndpointId)
+    });
+
+    if (uniqueId != nullptr && uniqueId[0] != '\0') {
+        pending->device->SetUniqueId(uniqueId);
+    } else {
+        pending->device->GenerateUniqueId();
+    }
+
+    // Staged, so Kotlin can seed values before the endpoint goes live without touching a device that still holds the
+    // endpoint ID (e.g. one whose removal is queued on the Matter thread)
+    pending->values = AttributeStore::GetInstance().Stage(pending->endpoint, endpointTemplate->storeAttributes);
+    VerifyOrReturnValue(pending->values != AttributeStore::kNoStaging, nullptr);
+    if (values != nullptr) {
+        for (const auto & value : *values) {
+            AttributeStore::GetInstance().SetStagedRawValue(pending->values, value.clusterId, value.attributeId,
+                                                            ByteSpan(value.bytes.data(), value.bytes.size()));
+        }
+    }
+
+    // Decided here rather than on the Matter thread, since it hashes every value; the publish step only has to move
+    // the kept versions on if a value changed meanwhile
+    if (pending->endpoint != chip::kInvalidEndpointId) {
+        pending->hasRememberedVersions = DataVersionStore::GetInstance().Take(pending->endpoint, pending->rememberedVersions);
+    }
+    if (pending->hasRememberedVersions) {
+        pending->valuesGeneration = AttributeStore::GetInstance().GetStagedGeneration(pending->values);
+        DataVersionStore::Apply(pending->rememberedVersions, *endpointTemplate, pending->values,
+                                pending->metadata->dataVersions, pending->keptVersions);
+    }
+
+    ChipLogProgress(Zcl, "addBridgedDevice: endpoint=%d, parentEndpoint=%d, name=%s, template=%" PRIu32 ", clusterCount=%zu", 
+                    endpoint, parentEndpointId, deviceName, endpointTemplate->id, clusterCount);
+    return pending;
+}
+
+// Undoes the parts of phase one that outlive the pending device, when it could not be published. Only touches state
+// the pending device created itself: another device may be live at the same endpoint ID.
+void DiscardGenericDevice(PendingGenericDevice & pending)
+{
+    AttributeStore::GetInstance().Unstage(pending.values);
+    pending.values = AttributeStore::kNoStaging;
+    if (pending.hasRememberedVersions) {
+        DataVersionStore::GetInstance().Remember(std::move(pending.rememberedVersions));
+        pending.hasRememberedVersions = false;
+    }
+}
+
+// Phase two, on the Matter thread: registers a prepared device with the Matter SDK and hands its storage over to the
+// endpoint tables. Returns its endpoint ID, or kInvalidEndpointId.
+chip::EndpointId PublishGenericDevice(PendingGenericDevice & pending)
+{
+    auto start = std::chrono::steady_clock::now();
+    const EndpointTemplate * endpointTemplate = pending.metadata->endpointTemplate;
+
+    int index = AddDeviceEndpoint(
+        pending.device.get(),
+        const_cast<EmberAfEndpointType *>(&endpointTemplate->endpointType),
+        endpointTemplate->deviceTypes,
+        Span<DataVersion>(pending.metadata->dataVersions, endpointTemplate->endpointType.clusterCount),
+        pending.endpoint,
+        #if CHIP_CONFIG_USE_ENDPOINT_UNIQUE_ID
+        CharSpan::fromCharString(pending.device->GetUniqueId()),
+        #endif
+        pending.parentEndpoint
+    );
+
+    chip::EndpointId endpointId = chip::kInvalidEndpointId;
+    if (index >= 0) {
+        // gDevices[index] and the endpoint table entry are already set by AddDeviceEndpoint
+        DeviceGeneric * device = pending.device.release();
+        endpointId             = device->GetEndpointId();
+        EndpointTable::GetInstance().SetType(endpointId, DeviceType::Generic);
+        gDynamicDevices[index]   = true;
+        gEndpointMetadata[index] = std::move(pending.metadata);
+        uint64_t generation      = 0;
+        AttributeStore::GetInstance().Install(pending.values, endpointId, &generation);
+        pending.values = AttributeStore::kNoStaging;
+        // Not reported yet: a cluster that kept its remembered version but had a value set since must still move on
+        if (generation != pending.valuesGeneration) {
+            for (uint8_t cluster : pending.keptVersions) {
+                gEndpointMetadata[index]->dataVersions[cluster]++;
             }
-            
-            delete ctx;
-        }, reinterpret_cast<intptr_t>(ctx));
-    
+        }
+        RegistrySnapshot::GetInstance().MarkDirty();
+    } else {
+        gPublishFailures++;
+        DiscardGenericDevice(pending);
+    }
+
+    uint64_t elapsedNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    gPublishCount++;
+    gPublishTotalNs += elapsedNs;
+    // only the Matter thread writes it
+    if (elapsedNs > gPublishMaxNs) {
+        gPublishMaxNs = elapsedNs;
+    }
+
+    if (index < 0) {
+        ChipLogError(Zcl, "Failed to add generic device at endpoint %d", pending.endpoint);
+    }
+    return endpointId;
+}
+
+// Takes over the device reference on endpointTemplate
+jboolean AddGenericDevice(const EndpointTemplate * endpointTemplate, jint endpoint, jint parentEndpointId, const char * deviceName)
+{
+    std::unique_ptr<PendingGenericDevice> pending = PrepareGenericDevice(endpointTemplate, endpoint, parentEndpointId, deviceName);
+    VerifyOrReturnValue(pending != nullptr, JNI_FALSE);
+
+    // owned by the task from here on, which may run before ScheduleWork returns
+    PendingGenericDevice * prepared = pending.release();
+    CHIP_ERROR err                  = chip::DeviceLayer::PlatformMgr().ScheduleWork(
+        [](intptr_t arg) {
+            std::unique_ptr<PendingGenericDevice> device(reinterpret_cast<PendingGenericDevice *>(arg));
+            PublishGenericDevice(*device);
+        }, reinterpret_cast<intptr_t>(prepared));
+    if (err != CHIP_NO_ERROR) {
+        ChipLogError(Zcl, "addBridgedDevice: failed to schedule registration: %" CHIP_ERROR_FORMAT, err.Format());
+        DiscardGenericDevice(*prepared);
+        delete prepared;
+        return JNI_FALSE;
+    }
     return JNI_TRUE;
 }
 
-extern "C" JNIEXPORT jboolean JNICALL Java_com_matter_bridge_app_BridgeApp_updateClusterAttribute__IIIJ(JNIEnv *, jobject, jint endpoint, jint clusterId, jint attributeId, jlong value)
+// One DeviceSpec of addBridgedDevices, read from Java before the devices are prepared on the WorkerPool
+struct BulkAddSpec
 {
-    ChipLogProgress(Zcl, "updateClusterAttribute (long): endpoint=%d, cluster=0x%x, attr=0x%x, value=%ld", 
-                    endpoint, clusterId, attributeId, (long)value);
+    const EndpointTemplate * endpointTemplate = nullptr; // null where the spec was rejected
+    jint endpoint                             = 0;
+    jint parentEndpointId                     = 0;
+    std::string name;
+};
 
-    uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(static_cast<chip::EndpointId>(endpoint));
-    
-    if (endpointIndex >= CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT)
+// Devices of one addBridgedDevices call, registered by a single Matter-thread task
+struct BulkAddContext
+{
+    jint requestId;
+    std::chrono::steady_clock::time_point start;
+    std::vector<std::unique_ptr<PendingGenericDevice>> devices; // null where the spec was rejected
+};
+
+std::atomic<jint> gNextBulkAddRequestId{ 1 };
+
+// Parses one DeviceSpec and acquires its template; nullptr if the spec is invalid
+const EndpointTemplate * AcquireSpecTemplate(JNIEnv * env, jobject spec, const BridgeAppJNI::DeviceSpecFields & fields)
+{
+    jint templateId = env->GetIntField(spec, fields.templateId);
+    if (templateId != static_cast<jint>(EndpointTemplateRegistry::kInvalidTemplate)) {
+        return EndpointTemplateRegistry::GetInstance().Acquire(static_cast<uint32_t>(templateId));
+    }
+
+    jintArray clusterIds    = static_cast<jintArray>(env->GetObjectField(spec, fields.clusterIds));
+    jobjectArray attributes = static_cast<jobjectArray>(env->GetObjectField(spec, fields.attributes));
+    jintArray deviceTypeIds = static_cast<jintArray>(env->GetObjectField(spec, fields.deviceTypeIds));
+
+    DeviceSchema schema;
+    EndpointDefinition definition;
+    ReadDeviceSchema(env, clusterIds, attributes, deviceTypeIds, schema);
+    BuildEndpointDefinition(schema, definition);
+
+    env->DeleteLocalRef(clusterIds);
+    env->DeleteLocalRef(attributes);
+    env->DeleteLocalRef(deviceTypeIds);
+    return EndpointTemplateRegistry::GetInstance().Acquire(std::move(definition));
+}
+
+} // namespace
+
+JNI_METHOD(jboolean, addBridgedDevice)(JNIEnv * env, jobject, jint endpoint, jint parentEndpointId, jstring name, jintArray clusterIds, jobjectArray attributes, jintArray deviceTypeIds)
+{
+    chip::JniUtfString deviceName(env, name);
+    VerifyOrReturnValue(deviceName.c_str() != nullptr, JNI_FALSE, ChipLogError(Zcl, "addBridgedDevice: null name"));
+
+    DeviceSchema schema;
+    EndpointDefinition definition;
+    ReadDeviceSchema(env, clusterIds, attributes, deviceTypeIds, schema);
+    BuildEndpointDefinition(schema, definition);
+    const EndpointTemplate * endpointTemplate = EndpointTemplateRegistry::GetInstance().Acquire(std::move(definition));
+    VerifyOrReturnValue(endpointTemplate != nullptr, JNI_FALSE);
+    return AddGenericDevice(endpointTemplate, endpoint, parentEndpointId, deviceName.c_str());
+}
+
+// Registers a device definition once; devices are then added by template ID without passing it again.
+// Returns the template ID (identical definitions share one), or -1.
+JNI_METHOD(jint, registerDeviceTemplate)(JNIEnv * env, jobject, jintArray clusterIds, jobjectArray attributes, jintArray deviceTypeIds)
+{
+    DeviceSchema schema;
+    EndpointDefinition definition;
+    ReadDeviceSchema(env, clusterIds, attributes, deviceTypeIds, schema);
+    BuildEndpointDefinition(schema, definition);
+    uint32_t templateId = EndpointTemplateRegistry::GetInstance().Register(std::move(definition));
+    VerifyOrReturnValue(templateId != EndpointTemplateRegistry::kInvalidTemplate, -1);
+    return static_cast<jint>(templateId);
+}
+
+// addBridgedDevice and registerDeviceTemplate taking packed (cluster, attribute, type, size, mask) attribute tuples instead
+// of ClusterAttribute objects; bound explicitly in JNI_OnLoad next to the object overloads
+static jboolean JNICALL AddBridgedDevicePacked(JNIEnv * env, jobject, jint endpoint, jint parentEndpointId, jstring name,
+                                               jintArray clusterIds, jintArray packedAttributes, jintArray deviceTypeIds)
+{
+    chip::JniUtfString deviceName(env, name);
+    VerifyOrReturnValue(deviceName.c_str() != nullptr, JNI_FALSE, ChipLogError(Zcl, "addBridgedDevice: null name"));
+
+    DeviceSchema schema;
+    EndpointDefinition definition;
+    VerifyOrReturnValue(ReadPackedDeviceSchema(env, clusterIds, packedAttributes, deviceTypeIds, schema), JNI_FALSE);
+    BuildEndpointDefinition(schema, definition);
+    const EndpointTemplate * endpointTemplate = EndpointTemplateRegistry::GetInstance().Acquire(std::move(definition));
+    VerifyOrReturnValue(endpointTemplate != nullptr, JNI_FALSE);
+    return AddGenericDevice(endpointTemplate, endpoint, parentEndpointId, deviceName.c_str());
+}
+
+static jint JNICALL RegisterDeviceTemplatePacked(JNIEnv * env, jobject, jintArray clusterIds, jintArray packedAttributes,
+                                                 jintArray deviceTypeIds)
+{
+    DeviceSchema schema;
+    EndpointDefinition definition;
+    VerifyOrReturnValue(ReadPackedDeviceSchema(env, clusterIds, packedAttributes, deviceTypeIds, schema), -1);
+    BuildEndpointDefinition(schema, definition);
+    uint32_t templateId = EndpointTemplateRegistry::GetInstance().Register(std::move(definition));
+    VerifyOrReturnValue(templateId != EndpointTemplateRegistry::kInvalidTemplate, -1);
+    return static_cast<jint>(templateId);
+}
+
+JNI_METHOD(jboolean, addBridgedDeviceFromTemplate)(JNIEnv * env, jobject, jint templateId, jint endpoint, jint parentEndpointId, jstring name)
+{
+    chip::JniUtfString deviceName(env, name);
+    VerifyOrReturnValue(deviceName.c_str() != nullptr, JNI_FALSE, ChipLogError(Zcl, "addBridgedDevice: null name"));
+
+    const EndpointTemplate * endpointTemplate =
+        EndpointTemplateRegistry::GetInstance().Acquire(static_cast<uint32_t>(templateId));
+    VerifyOrReturnValue(endpointTemplate != nullptr, JNI_FALSE,
+                        ChipLogError(Zcl, "addBridgedDeviceFromTemplate: unknown template %d", templateId));
+    return AddGenericDevice(endpointTemplate, endpoint, parentEndpointId, deviceName.c_str());
+}
+
+// Adds many devices in one JNI crossing: all specs are parsed here, the devices prepared in parallel on the WorkerPool
+// and all endpoints registered by one Matter-thread task, which then reports the endpoint of each device (-1 if it failed) and the time since this call through
+// postBridgedDevicesAdded. Returns the request ID passed to that callback, or -1 if nothing was scheduled.
+JNI_METHOD(jint, addBridgedDevices)(JNIEnv * env, jobject, jobjectArray specs)
+{
+    VerifyOrReturnValue(specs != nullptr, -1, ChipLogError(Zcl, "addBridgedDevices: null specs"));
+
+    std::unique_ptr<BulkAddContext> ctx(new BulkAddContext{ gNextBulkAddRequestId++, std::chrono::steady_clock::now(), {} });
+
+    const BridgeAppJNI::DeviceSpecFields * fields = BridgeAppJNIMgr().GetDeviceSpecFields();
+    VerifyOrReturnValue(fields != nullptr, -1, ChipLogError(Zcl, "addBridgedDevices: DeviceSpec fields not resolved"));
+
+    // JNI access stays on this thread; the devices are then prepared in parallel
+    jsize count = env->GetArrayLength(specs);
+    std::vector<BulkAddSpec> parsed(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; i++)
     {
-        ChipLogError(Zcl, "updateClusterAttribute (long): Invalid endpoint %d", endpoint);
-        return JNI_FALSE;
+        jobject spec = env->GetObjectArrayElement(specs, i);
+        if (spec == nullptr)
+        {
+            continue;
+        }
+
+        jstring name = static_cast<jstring>(env->GetObjectField(spec, fields->name));
+        {
+            // released before the local reference it reads from is deleted
+            chip::JniUtfString deviceName(env, name);
+            const EndpointTemplate * endpointTemplate = (deviceName.c_str() != nullptr)
+                ? AcquireSpecTemplate(env, spec, *fields)
+                : nullptr;
+            if (endpointTemplate != nullptr)
+            {
+                parsed[static_cast<size_t>(i)] = BulkAddSpec{ endpointTemplate, env->GetIntField(spec, fields->endpoint),
+                                                              env->GetIntField(spec, fields->parentEndpointId),
+                                                              deviceName.c_str() };
+            }
+            else
+            {
+                ChipLogError(Zcl, "addBridgedDevices: invalid spec %d", static_cast<int>(i));
+            }
+        }
+
+        env->DeleteLocalRef(name);
+        env->DeleteLocalRef(spec);
     }
 
-    Device * dev = gDevices[endpointIndex];
-    if (dev == nullptr)
+    ctx->devices.resize(parsed.size());
+    WorkerPool::GetInstance().ParallelFor(parsed.size(), [&parsed, &ctx](size_t i) {
+        const BulkAddSpec & spec = parsed[i];
+        if (spec.endpointTemplate != nullptr)
+        {
+            ctx->devices[i] = PrepareGenericDevice(spec.endpointTemplate, spec.endpoint, spec.parentEndpointId, spec.name.c_str());
+        }
+    });
+
+    // owned by the task from here on, which may run before ScheduleWork returns
+    jint requestId           = ctx->requestId;
+    BulkAddContext * bulkAdd = ctx.release();
+    CHIP_ERROR err           = chip::DeviceLayer::PlatformMgr().ScheduleWork(
+        [](intptr_t arg) {
+            std::unique_ptr<BulkAddContext> bulk(reinterpret_cast<BulkAddContext *>(arg));
+            auto publishStart = std::chrono::steady_clock::now();
+
+            std::vector<jint> endpoints(bulk->devices.size(), -1);
+            size_t added = 0;
+            for (size_t i = 0; i < bulk->devices.size(); i++)
+            {
+                chip::EndpointId endpointId =
+                    (bulk->devices[i] != nullptr) ? PublishGenericDevice(*bulk->devices[i]) : chip::kInvalidEndpointId;
+                if (endpointId != chip::kInvalidEndpointId)
+                {
+                    endpoints[i] = static_cast<jint>(endpointId);
+                    added++;
+                }
+            }
+
+            auto now           = std::chrono::steady_clock::now();
+            uint64_t elapsedUs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - bulk->start).count());
+            uint64_t publishUs = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - publishStart).count());
+            ChipLogProgress(Zcl, "addBridgedDevices: request %d, %u of %u devices online after %" PRIu64 " us (%" PRIu64
+                            " us on the Matter thread)",
+                            static_cast<int>(bulk->requestId), static_cast<unsigned>(added),
+                            static_cast<unsigned>(bulk->devices.size()), elapsedUs, publishUs);
+            BridgeAppJNIMgr().PostBridgedDevicesAdded(bulk->requestId, endpoints, elapsedUs);
+        },
+        reinterpret_cast<intptr_t>(bulkAdd));
+    if (err != CHIP_NO_ERROR)
     {
+        ChipLogError(Zcl, "addBridgedDevices: failed to schedule registration: %" CHIP_ERROR_FORMAT, err.Format());
+        for (auto & pending : bulkAdd->devices)
+        {
+            if (pending != nullptr)
+            {
+                DiscardGenericDevice(*pending);
+            }
+        }
+        delete bulkAdd;
+        return -1;
+    }
+    return requestId;
+}
+
+// Collects the generic devices and their templates for the registry snapshot. Only the topology is read under the
+// stack lock; values are then copied from the AttributeStore, which has its own lock, so the Matter thread is not held
+// up in proportion to the number of devices.
+void CollectRegistrySnapshot(RegistrySnapshot::Contents & contents)
+{
+    // a device found under the stack lock, with a reference on its template until its values are read
+    struct CollectedDevice
+    {
+        const EndpointTemplate * endpointTemplate;
+        std::vector<DataVersion> dataVersions;
+    };
+
+    EndpointTemplateRegistry & registry = EndpointTemplateRegistry::GetInstance();
+    std::vector<CollectedDevice> collected;
+    std::set<uint32_t> templateIds;
+    {
+        chip::DeviceLayer::StackLock lock;
+        for (uint16_t index = 0; index < CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT; index++)
+        {
+            const DynamicEndpointMetadata * metadata = gEndpointMetadata[index].get();
+            Device * device                          = gDevices[index];
+            if (metadata == nullptr || device == nullptr)
+            {
+                continue;
+            }
+
+            const EndpointTemplate * endpointTemplate = registry.Acquire(metadata->endpointTemplate);
+            const DataVersion * versions              = metadata->dataVersions;
+            collected.push_back({ endpointTemplate, std::vector<DataVersion>(
+                                                        versions, versions + endpointTemplate->endpointType.clusterCount) });
+
+            RegistrySnapshot::DeviceRecord record;
+            record.endpoint       = device->GetEndpointId();
+            record.parentEndpoint = device->GetParentEndpointId();
+            record.templateId     = endpointTemplate->id;
+            record.name           = device->GetName();
+            record.uniqueId       = device->GetUniqueId();
+            contents.devices.push_back(std::move(record));
+        }
+    }
+
+    for (size_t i = 0; i < collected.size(); i++)
+    {
+        const EndpointTemplate * endpointTemplate = collected[i].endpointTemplate;
+        RegistrySnapshot::DeviceRecord & record   = contents.devices[i];
+        if (templateIds.insert(endpointTemplate->id).second)
+        {
+            contents.templates.push_back(
+                { endpointTemplate->id, registry.IsRegistered(endpointTemplate), endpointTemplate->ToDefinition() });
+        }
+
+        // Java-owned values are read from Kotlin again, constants come with the template
+        for (const auto & desc : endpointTemplate->storeAttributes)
+        {
+            if (desc.flags & (AttributeStore::kFlag_JavaOwned | AttributeStore::kFlag_Constant))
+            {
+                continue;
+            }
+            RegistrySnapshot::Value value{ desc.clusterId, desc.attributeId, {} };
+            if (AttributeStore::GetInstance().GetRawValue(record.endpoint, desc.clusterId, desc.attributeId, value.bytes) ==
+                CHIP_NO_ERROR)
+            {
+                record.values.push_back(std::move(value));
+            }
+        }
+        contents.dataVersions.push_back(
+            DataVersionStore::Capture(record.endpoint, *endpointTemplate, collected[i].dataVersions.data()));
+        registry.Release(endpointTemplate);
+    }
+    DataVersionStore::GetInstance().GetEntries(contents.dataVersions);
+}
+
+namespace {
+
+// Devices of the registry snapshot, prepared before the Matter thread publishes them
+struct RestoreContext
+{
+    std::chrono::steady_clock::time_point start;
+    std::vector<std::unique_ptr<PendingGenericDevice>> devices;  // null where the device could not be prepared
+    std::vector<BridgeAppJNI::RestoredDevice> restoredDevices;   // by index in devices
+};
+
+// Written by postServerInit before it schedules the publish task, which consumes it
+std::unique_ptr<RestoreContext> gPreparedSnapshot;
+
+} // namespace
+
+void PrepareRegistrySnapshot()
+{
+    RegistrySnapshot & snapshot = RegistrySnapshot::GetInstance();
+    VerifyOrReturn(snapshot.IsConfigured());
+
+    std::unique_ptr<RestoreContext> restore(new RestoreContext{ std::chrono::steady_clock::now(), {}, {} });
+    bool cleanShutdown = snapshot.ConsumeCleanShutdownMarker();
+    RegistrySnapshot::Contents contents;
+    VerifyOrReturn(snapshot.Load(contents), ChipLogProgress(Zcl, "RestoreRegistrySnapshot: no snapshot to restore"));
+
+    // After a crash, clusters may have reached later versions (with other data) than the snapshot holds; reusing one
+    // would make a controller's DataVersion filter skip data it never saw, so every device starts from random versions
+    if (!cleanShutdown)
+    {
+        ChipLogProgress(Zcl, "RestoreRegistrySnapshot: previous run did not shut down cleanly, DataVersions start over");
+        contents.dataVersions.clear();
+    }
+
+    // taken by PrepareGenericDevice for restored devices, kept for devices Kotlin adds again later
+    for (auto & entry : contents.dataVersions)
+    {
+        DataVersionStore::GetInstance().Remember(std::move(entry));
+    }
+
+    // One reference per template keeps it interned while its devices are created, whatever order they come in
+    EndpointTemplateRegistry & registry = EndpointTemplateRegistry::GetInstance();
+    std::map<uint32_t, const EndpointTemplate *> templates;
+    for (auto & record : contents.templates)
+    {
+        for (auto & cluster : record.definition.clusters)
+        {
+            cluster.acceptedCommandList = AcceptedCommandsFor(cluster.clusterId);
+        }
+        const EndpointTemplate * endpointTemplate = record.registered
+            ? registry.Acquire(registry.Register(std::move(record.definition)))
+            : registry.Acquire(std::move(record.definition));
+        if (endpointTemplate == nullptr)
+        {
+            ChipLogError(Zcl, "RestoreRegistrySnapshot: failed to rebuild template %" PRIu32, record.id);
+            continue;
+        }
+        templates[record.id] = endpointTemplate;
+    }
+
+    restore->devices.resize(contents.devices.size());
+    restore->restoredDevices.resize(contents.devices.size());
+    WorkerPool::GetInstance().ParallelFor(contents.devices.size(), [&](size_t i) {
+        const RegistrySnapshot::DeviceRecord & record = contents.devices[i];
+        auto it                                       = templates.find(record.templateId);
+        if (it == templates.end())
+        {
+            return;
+        }
+
+        std::unique_ptr<PendingGenericDevice> pending =
+            PrepareGenericDevice(registry.Acquire(it->second), record.endpoint, record.parentEndpoint, record.name.c_str(),
+                                 record.uniqueId.c_str(), &record.values);
+        if (pending == nullptr)
+        {
+            return;
+        }
+
+        BridgeAppJNI::RestoredDevice & device = restore->restoredDevices[i];
+        device                                = { record.endpoint, record.parentEndpoint, record.name, {}, {} };
+        for (const auto & deviceType : it->second->deviceTypes)
+        {
+            device.deviceTypeIds.push_back(static_cast<jint>(deviceType.deviceTypeId));
+        }
+        for (uint8_t j = 0; j < it->second->endpointType.clusterCount; j++)
+        {
+            device.clusterIds.push_back(static_cast<jint>(it->second->endpointType.cluster[j].clusterId));
+        }
+        restore->devices[i] = std::move(pending);
+    });
+
+    // every prepared device holds its own reference
+    for (const auto & entry : templates)
+    {
+        registry.Release(entry.second);
+    }
+    gPreparedSnapshot = std::move(restore);
+}
+
+// On the Matter thread, once the EndpointAllocator is initialized
+void PublishRegistrySnapshot()
+{
+    std::unique_ptr<RestoreContext> restore = std::move(gPreparedSnapshot);
+    VerifyOrReturn(restore != nullptr);
+
+    auto publishStart = std::chrono::steady_clock::now();
+    std::vector<BridgeAppJNI::RestoredDevice> restored;
+    for (size_t i = 0; i < restore->devices.size(); i++)
+    {
+        if (restore->devices[i] != nullptr && PublishGenericDevice(*restore->devices[i]) != chip::kInvalidEndpointId)
+        {
+            restored.push_back(std::move(restore->restoredDevices[i]));
+        }
+    }
+
+    auto now           = std::chrono::steady_clock::now();
+    uint64_t elapsedUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - restore->start).count());
+    uint64_t publishUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - publishStart).count());
+    ChipLogProgress(Zcl, "RestoreRegistrySnapshot: %u of %u devices restored in %" PRIu64 " us (%" PRIu64 " us on the Matter thread)",
+                    static_cast<unsigned>(restored.size()), static_cast<unsigned>(restore->devices.size()), elapsedUs, publishUs);
+    BridgeAppJNIMgr().PostBridgedDevicesRestored(restored, elapsedUs);
+}
+
+// When the publish task could not be scheduled
+void DiscardRegistrySnapshot()
+{
+    std::unique_ptr<RestoreContext> restore = std::move(gPreparedSnapshot);
+    VerifyOrReturn(restore != nullptr);
+
+    for (auto & pending : restore->devices)
+    {
+        if (pending != nullptr)
+        {
+            DiscardGenericDevice(*pending);
+        }
+    }
+}
+
+// Enables the registry snapshot; must be called before postServerInit for the snapshot to be restored.
+// Returns true if the file holds a snapshot, whose devices will then be re-created natively.
+JNI_METHOD(jboolean, setRegistrySnapshotPath)(JNIEnv * env, jobject, jstring path)
+{
+    VerifyOrReturnValue(path != nullptr, JNI_FALSE, ChipLogError(Zcl, "setRegistrySnapshotPath: null path"));
+
+    chip::JniUtfString snapshotPath(env, path);
+    VerifyOrReturnValue(snapshotPath.c_str() != nullptr, JNI_FALSE);
+    return RegistrySnapshot::GetInstance().Configure(snapshotPath.c_str(), CollectRegistrySnapshot) ? JNI_TRUE : JNI_FALSE;
+}
+
+// Writes the snapshot now, e.g. before the app is stopped, as a clean shutdown: its DataVersions are trusted at the
+// next start unless something changes before the process ends. Must not be called on the Matter thread.
+JNI_METHOD(jboolean, saveRegistrySnapshot)(JNIEnv *, jobject)
+{
+    return RegistrySnapshot::GetInstance().Save(true) ? JNI_TRUE : JNI_FALSE;
+}
+
+// Both updateClusterAttribute overloads are bound explicitly in JNI_OnLoad, so they need no mangled symbol names
+static jboolean JNICALL UpdateClusterAttributeLong(JNIEnv *, jobject, jint endpoint, jint clusterId, jint attributeId, jlong value)
+{
+    ChipLogProgress(Zcl, "updateClusterAttribute (long): endpoint=%d, cluster=0x%x, attr=0x%x, value=%ld", 
+                    endpoint, clusterId, attributeId, (long)value);
+
+    bool changed = true;
+    bool stored  = AttributeStore::GetInstance().SetValue(static_cast<chip::EndpointId>(endpoint),
+                                                         static_cast<chip::ClusterId>(clusterId),
+                                                         static_cast<chip::AttributeId>(attributeId),
+                                                         static_cast<uint64_t>(value), &changed) == CHIP_NO_ERROR;
+
+    if (EndpointTable::GetInstance().GetDevice(static_cast<chip::EndpointId>(endpoint)) == nullptr)
+    {
+        // Not live yet: the stored value is served once the endpoint is registered
+        VerifyOrReturnValue(!stored, JNI_TRUE);
         ChipLogError(Zcl, "updateClusterAttribute (long): Device not found for endpoint %d", endpoint);
         return JNI_FALSE;
     }
 
-    // Mark attribute as changed - must be done on Matter thread
-    chip::DeviceLayer::PlatformMgr().ScheduleWork(
-        [](intptr_t context) {
-            auto * data = reinterpret_cast<std::tuple<chip::EndpointId, chip::ClusterId, chip::AttributeId>*>(context);
-            MatterReportingAttributeChangeCallback(std::get<0>(*data), std::get<1>(*data), std::get<2>(*data));
-            delete data;
-        },
-        reinterpret_cast<intptr_t>(new std::tuple<chip::EndpointId, chip::ClusterId, chip::AttributeId>(
-            static_cast<chip::EndpointId>(endpoint),
-            static_cast<chip::ClusterId>(clusterId),
-            static_cast<chip::AttributeId>(attributeId)
-        ))
-    );
+    // Report from the Matter thread, coalesced with other pending changes
+    ReportUpdate(static_cast<chip::EndpointId>(endpoint), static_cast<chip::ClusterId>(clusterId),
+                 static_cast<chip::AttributeId>(attributeId), changed);
     
     return JNI_TRUE;
 }
 
 // Overload for byte array values (String, complex types)
-// Note: JNI requires mangled names for overloaded methods
-extern "C" JNIEXPORT jboolean JNICALL Java_com_matter_bridge_app_BridgeApp_updateClusterAttribute__III_3B(JNIEnv * env, jobject, jint endpoint, jint clusterId, jint attributeId, jbyteArray value)
+static jboolean JNICALL UpdateClusterAttributeBytes(JNIEnv * env, jobject, jint endpoint, jint clusterId, jint attributeId, jbyteArray value)
 {
     if (value == nullptr)
     {
@@ -1505,55 +2730,521 @@ extern "C" JNIEXPORT jboolean JNICALL Java_com_matter_bridge_app_BridgeApp_updat
     ChipLogProgress(Zcl, "updateClusterAttribute (byte[]): endpoint=%d, cluster=0x%x, attr=0x%x, valueLen=%d", 
                     endpoint, clusterId, attributeId, valueLen);
 
-    uint16_t endpointIndex = emberAfGetDynamicIndexFromEndpoint(static_cast<chip::EndpointId>(endpoint));
-    
-    if (endpointIndex >= CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT)
+    // Get byte array data
+    jbyte* bytes = env->GetByteArrayElements(value, nullptr);
+    if (bytes == nullptr)
     {
-        ChipLogError(Zcl, "updateClusterAttribute (byte[]): Invalid endpoint %d", endpoint);
+        ChipLogError(Zcl, "updateClusterAttribute (byte[]): Failed to get byte array elements");
         return JNI_FALSE;
     }
 
-    Device * dev = gDevices[endpointIndex];
-    if (dev == nullptr)
+    // Keep the value natively so reads of this attribute no longer cross JNI
+    bool changed = true;
+    bool stored  = AttributeStore::GetInstance().SetValue(
+                      static_cast<chip::EndpointId>(endpoint), static_cast<chip::ClusterId>(clusterId),
+                      static_cast<chip::AttributeId>(attributeId),
+                      ByteSpan(reinterpret_cast<const uint8_t *>(bytes), static_cast<size_t>(valueLen)), &changed) == CHIP_NO_ERROR;
+
+    env->ReleaseByteArrayElements(value, bytes, JNI_ABORT);
+
+    if (EndpointTable::GetInstance().GetDevice(static_cast<chip::EndpointId>(endpoint)) == nullptr)
     {
+        // Not live yet: the stored value is served once the endpoint is registered
+        VerifyOrReturnValue(!stored, JNI_TRUE);
         ChipLogError(Zcl, "updateClusterAttribute (byte[]): Device not found for endpoint %d", endpoint);
         return JNI_FALSE;
     }
+    
+    // Report from the Matter thread, coalesced with other pending changes
+    ReportUpdate(static_cast<chip::EndpointId>(endpoint), static_cast<chip::ClusterId>(clusterId),
+                 static_cast<chip::AttributeId>(attributeId), changed);
+    
+    return JNI_TRUE;
+}
 
-    // Get byte array data
-    jbyte* bytes = env->GetByteArrayElements(value, nullptr);
-    if (bytes == nullptr)
+
+// Shared attribute region: Kotlin writes values in place into a direct ByteBuffer laid out like the native
+// attribute store, then publishes them with markAttributeDirty. No byte[] is allocated per update.
+JNI_METHOD(jint, getAttributeBufferSize)(JNIEnv *, jobject, jint endpoint)
+{
+    return static_cast<jint>(AttributeStore::GetInstance().GetBlockSize(static_cast<chip::EndpointId>(endpoint)));
+}
+
+JNI_METHOD(jboolean, attachAttributeBuffer)(JNIEnv * env, jobject, jint endpoint, jobject buffer)
+{
+    VerifyOrReturnValue(buffer != nullptr, JNI_FALSE, ChipLogError(Zcl, "attachAttributeBuffer: null buffer"));
+
+    uint8_t * address = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+    jlong capacity    = env->GetDirectBufferCapacity(buffer);
+    VerifyOrReturnValue(address != nullptr && capacity > 0, JNI_FALSE,
+                        ChipLogError(Zcl, "attachAttributeBuffer: endpoint %d buffer is not direct", endpoint));
+
+    // The store keeps the ByteBuffer alive until the endpoint is dropped
+    jobject globalBuffer = env->NewGlobalRef(buffer);
+    VerifyOrReturnValue(globalBuffer != nullptr, JNI_FALSE, ChipLogError(Zcl, "attachAttributeBuffer: NewGlobalRef failed"));
+    std::shared_ptr<uint8_t> block(address, [globalBuffer](uint8_t *) {
+        JNIEnv * deleterEnv = JniEnvCache::GetEnv();
+        if (deleterEnv != nullptr)
+        {
+            deleterEnv->DeleteGlobalRef(globalBuffer);
+        }
+    });
+
+    CHIP_ERROR err = AttributeStore::GetInstance().AttachBlock(static_cast<chip::EndpointId>(endpoint), std::move(block),
+                                                               static_cast<size_t>(capacity));
+    VerifyOrReturnValue(err == CHIP_NO_ERROR, JNI_FALSE,
+                        ChipLogError(Zcl, "attachAttributeBuffer: endpoint %d: %" CHIP_ERROR_FORMAT, endpoint, err.Format()));
+    return JNI_TRUE;
+}
+
+JNI_METHOD(jint, getAttributeOffset)(JNIEnv *, jobject, jint endpoint, jint clusterId, jint attributeId)
+{
+    uint32_t offset   = 0;
+    uint16_t capacity = 0;
+    CHIP_ERROR err    = AttributeStore::GetInstance().GetSlot(static_cast<chip::EndpointId>(endpoint),
+                                                              static_cast<chip::ClusterId>(clusterId),
+                                                              static_cast<chip::AttributeId>(attributeId), offset, capacity);
+    return (err == CHIP_NO_ERROR) ? static_cast<jint>(offset) : -1;
+}
+
+// Results of markAttributeDirty, see BridgeApp.MARK_DIRTY_*
+constexpr jint kMarkDirtyOk       = 0;
+constexpr jint kMarkDirtyDetached = 1;
+constexpr jint kMarkDirtyRetry    = 2;
+constexpr jint kMarkDirtyFailed   = 3;
+
+JNI_METHOD(jint, markAttributeDirty)(JNIEnv * env, jobject, jint endpoint, jobject buffer, jint clusterId, jint attributeId)
+{
+    VerifyOrReturnValue(buffer != nullptr, kMarkDirtyFailed, ChipLogError(Zcl, "markAttributeDirty: null buffer"));
+    const uint8_t * block = static_cast<const uint8_t *>(env->GetDirectBufferAddress(buffer));
+    VerifyOrReturnValue(block != nullptr, kMarkDirtyFailed);
+
+    bool changed   = true;
+    CHIP_ERROR err = AttributeStore::GetInstance().MarkDirty(static_cast<chip::EndpointId>(endpoint),
+                                                             static_cast<chip::ClusterId>(clusterId),
+                                                             static_cast<chip::AttributeId>(attributeId), block, &changed);
+    // A stale buffer (endpoint removed and added again) or a write in progress are expected: the caller recovers
+    VerifyOrReturnValue(err != CHIP_ERROR_INCORRECT_STATE, kMarkDirtyDetached);
+    VerifyOrReturnValue(err != CHIP_ERROR_BUSY, kMarkDirtyRetry);
+    VerifyOrReturnValue(err == CHIP_NO_ERROR, kMarkDirtyFailed,
+                        ChipLogError(Zcl, "markAttributeDirty: endpoint %d: %" CHIP_ERROR_FORMAT, endpoint, err.Format()));
+
+    // Only report once the endpoint is live; before that the value is simply served on first read
+    if (EndpointTable::GetInstance().GetDevice(static_cast<chip::EndpointId>(endpoint)) != nullptr)
     {
-        ChipLogError(Zcl, "updateClusterAttribute (byte[]): Failed to get byte array elements");
-        return JNI_FALSE;
+        ReportUpdate(static_cast<chip::EndpointId>(endpoint), static_cast<chip::ClusterId>(clusterId),
+                     static_cast<chip::AttributeId>(attributeId), changed);
     }
+    return kMarkDirtyOk;
+}
 
-    // For now, just trigger the attribute change callback
-    // The actual value storage would depend on device implementation
-    // Matter stack will read the value via our HandleClusterAttributeRead callback
-    
-    ChipLogProgress(Zcl, "updateClusterAttribute (byte[]): Triggering attribute change notification");
-    
-    env->ReleaseByteArrayElements(value, bytes, JNI_ABORT);
-    
-    // Trigger attribute change callback to report to Matter stack - must be done on Matter thread
-    chip::DeviceLayer::PlatformMgr().ScheduleWork(
-        [](intptr_t context) {
-            auto * data = reinterpret_cast<std::tuple<chip::EndpointId, chip::ClusterId, chip::AttributeId>*>(context);
-            MatterReportingAttributeChangeCallback(std::get<0>(*data), std::get<1>(*data), std::get<2>(*data));
-            delete data;
-        },
-        reinterpret_cast<intptr_t>(new std::tuple<chip::EndpointId, chip::ClusterId, chip::AttributeId>(
-            static_cast<chip::EndpointId>(endpoint),
-            static_cast<chip::ClusterId>(clusterId),
-            static_cast<chip::AttributeId>(attributeId)
-        ))
-    );
-    
+// Negative read cache counters: { reads answered natively as unsupported, null answers from Java }
+JNI_METHOD(jlongArray, getNegativeCacheStats)(JNIEnv * env, jobject)
+{
+    jlong stats[] = { static_cast<jlong>(AttributeStore::GetInstance().GetNegativeCacheHits()),
+                      static_cast<jlong>(AttributeStore::GetInstance().GetNegativeCacheMisses()) };
+
+    jlongArray array = env->NewLongArray(2);
+    VerifyOrReturnValue(array != nullptr, nullptr, ChipLogError(Zcl, "getNegativeCacheStats: NewLongArray failed"));
+    env->SetLongArrayRegion(array, 0, 2, stats);
+    return array;
+}
+
+// Threads attached to / detached from the VM by the JNIEnv cache: { attaches, detaches }
+JNI_METHOD(jlongArray, getJniAttachStats)(JNIEnv * env, jobject)
+{
+    jlong stats[] = { static_cast<jlong>(JniEnvCache::GetAttachCount()), static_cast<jlong>(JniEnvCache::GetDetachCount()) };
+
+    jlongArray array = env->NewLongArray(2);
+    VerifyOrReturnValue(array != nullptr, nullptr, ChipLogError(Zcl, "getJniAttachStats: NewLongArray failed"));
+    env->SetLongArrayRegion(array, 0, 2, stats);
+    return array;
+}
+
+#if BRIDGE_APP_READ_BENCHMARK
+// Profiling only, see bridge_app_read_benchmark in BUILD.gn
+JNI_METHOD(jlongArray, benchmarkReadProtocols)
+(JNIEnv * env, jobject, jint endpoint, jint clusterId, jint attributeId, jint reads, jint readsPerSecond)
+{
+    VerifyOrReturnValue(reads > 0 && readsPerSecond > 0, nullptr, ChipLogError(Zcl, "benchmarkReadProtocols: invalid arguments"));
+
+    const std::chrono::nanoseconds period = std::chrono::nanoseconds(std::chrono::seconds(1)) / readsPerSecond;
+    uint8_t buffer[BridgeAppJNI::kReadBufferSize];
+    jlong averages[2] = { 0, 0 };
+
+    // 0: byte[] returned from Java, 1: direct buffer filled by Java
+    for (int protocol = 0; protocol < 2; protocol++)
+    {
+        std::chrono::nanoseconds busy(0);
+        int failures = 0;
+        auto next    = std::chrono::steady_clock::now();
+        for (jint i = 0; i < reads; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (protocol == 0)
+            {
+                auto result = BridgeAppJNIMgr().HandleClusterAttributeRead(endpoint, clusterId, attributeId,
+                                                                         BridgeAppJNI::kReadBufferSize);
+                if (result.data() != nullptr && static_cast<size_t>(result.size()) <= sizeof(buffer))
+                {
+                    memcpy(buffer, result.data(), static_cast<size_t>(result.size()));
+                }
+                else
+                {
+                    failures++;
+                }
+            }
+            else if (BridgeAppJNIMgr().HandleClusterAttributeReadDirect(endpoint, clusterId, attributeId, buffer,
+                                                                      BridgeAppJNI::kReadBufferSize) < 0)
+            {
+                failures++;
+            }
+            busy += std::chrono::steady_clock::now() - start;
+
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+        averages[protocol] = static_cast<jlong>(busy.count() / reads);
+        if (failures > 0)
+        {
+            ChipLogError(Zcl, "benchmarkReadProtocols: protocol %d failed %d of %d reads", protocol, failures, reads);
+        }
+    }
+
+    ChipLogProgress(Zcl, "benchmarkReadProtocols: %d reads at %d/s, byte[] %" PRId64 " ns/read, direct buffer %" PRId64 " ns/read",
+                    reads, readsPerSecond, static_cast<int64_t>(averages[0]), static_cast<int64_t>(averages[1]));
+
+    jlongArray array = env->NewLongArray(2);
+    VerifyOrReturnValue(array != nullptr, nullptr, ChipLogError(Zcl, "benchmarkReadProtocols: NewLongArray failed"));
+    env->SetLongArrayRegion(array, 0, 2, averages);
+    return array;
+}
+#endif // BRIDGE_APP_READ_BENCHMARK
+
+// Typed updates for high-rate sensors. Annotated @FastNative on the Java side: primitives only and no GC state
+// transition, so they must stay short. They take the AttributeStore and ReportThrottle locks briefly and may schedule
+// the report drain, which is why they cannot be @CriticalNative.
+namespace {
+
+jboolean UpdateIntegerValue(jint endpoint, jint clusterId, jint attributeId, uint64_t value)
+{
+    bool changed = true;
+    bool stored  = AttributeStore::GetInstance().SetValue(static_cast<chip::EndpointId>(endpoint),
+                                                         static_cast<chip::ClusterId>(clusterId),
+                                                         static_cast<chip::AttributeId>(attributeId), value, &changed) == CHIP_NO_ERROR;
+
+    // Not live yet: the stored value is served once the endpoint is registered
+    VerifyOrReturnValue(EndpointTable::GetInstance().GetDevice(static_cast<chip::EndpointId>(endpoint)) != nullptr,
+                        stored ? JNI_TRUE : JNI_FALSE);
+
+    ReportUpdate(static_cast<chip::EndpointId>(endpoint), static_cast<chip::ClusterId>(clusterId),
+                 static_cast<chip::AttributeId>(attributeId), changed);
     return JNI_TRUE;
 }
 
+jboolean JNICALL UpdateBool(JNIEnv *, jclass, jint endpoint, jint clusterId, jint attributeId, jboolean value)
+{
+    return UpdateIntegerValue(endpoint, clusterId, attributeId, value ? 1u : 0u);
+}
+
+jboolean JNICALL UpdateInt(JNIEnv *, jclass, jint endpoint, jint clusterId, jint attributeId, jlong value)
+{
+    return UpdateIntegerValue(endpoint, clusterId, attributeId, static_cast<uint64_t>(value));
+}
+
+} // anonymous namespace
+
+// Report coalescing counters: { paths enqueued, duplicates merged before reporting, paths dropped on a full queue }
+JNI_METHOD(jlongArray, getReportQueueStats)(JNIEnv * env, jobject)
+{
+    jlong stats[] = { static_cast<jlong>(ReportQueue::GetInstance().GetEnqueuedCount()),
+                      static_cast<jlong>(ReportQueue::GetInstance().GetCoalescedCount()),
+                      static_cast<jlong>(ReportQueue::GetInstance().GetDroppedCount()) };
+
+    jlongArray array = env->NewLongArray(3);
+    VerifyOrReturnValue(array != nullptr, nullptr, ChipLogError(Zcl, "getReportQueueStats: NewLongArray failed"));
+    env->SetLongArrayRegion(array, 0, 3, stats);
+    return array;
+}
+
+// Applies many attribute updates in one JNI transition. Value i spans packedValues[offsets[i], offsets[i + 1]) and is
+// encoded like the byte[] updateClusterAttribute overload. Changed paths go through the report queue, which reports
+// all of them from a single Matter-thread task. Returns a bitmap (BitSet.valueOf layout) of the stored entries, or
+// null without applying anything if the arrays are inconsistent or an entry names an unknown endpoint or attribute.
+JNI_METHOD(jlongArray, updateClusterAttributes)
+(JNIEnv * env, jobject, jintArray endpoints, jintArray clusterIds, jintArray attributeIds, jbyteArray packedValues,
+ jintArray offsets)
+{
+    VerifyOrReturnValue(endpoints != nullptr && clusterIds != nullptr && attributeIds != nullptr && packedValues != nullptr &&
+                            offsets != nullptr,
+                        nullptr, ChipLogError(Zcl, "updateClusterAttributes: null array"));
+
+    jsize count       = env->GetArrayLength(endpoints);
+    jsize valuesBytes = env->GetArrayLength(packedValues);
+    VerifyOrReturnValue(env->GetArrayLength(clusterIds) == count && env->GetArrayLength(attributeIds) == count &&
+                            env->GetArrayLength(offsets) == count + 1,
+                        nullptr, ChipLogError(Zcl, "updateClusterAttributes: array lengths do not match"));
+
+    std::vector<jint> endpointValues(static_cast<size_t>(count));
+    std::vector<jint> clusterValues(static_cast<size_t>(count));
+    std::vector<jint> attributeValues(static_cast<size_t>(count));
+    std::vector<jint> offsetValues(static_cast<size_t>(count) + 1);
+    std::vector<uint8_t> values(static_cast<size_t>(valuesBytes));
+    env->GetIntArrayRegion(endpoints, 0, count, endpointValues.data());
+    env->GetIntArrayRegion(clusterIds, 0, count, clusterValues.data());
+    env->GetIntArrayRegion(attributeIds, 0, count, attributeValues.data());
+    env->GetIntArrayRegion(offsets, 0, count + 1, offsetValues.data());
+    env->GetByteArrayRegion(packedValues, 0, valuesBytes, reinterpret_cast<jbyte *>(values.data()));
+
+    // Validate the layout and the targets in one pass before touching any state
+    for (jsize i = 0; i < count; i++)
+    {
+        VerifyOrReturnValue(offsetValues[i] >= 0 && offsetValues[i] <= offsetValues[i + 1] && offsetValues[i + 1] <= valuesBytes,
+                            nullptr, ChipLogError(Zcl, "updateClusterAttributes: invalid offset at entry %d", i));
+        VerifyOrReturnValue(AttributeStore::GetInstance().HasAttribute(static_cast<chip::EndpointId>(endpointValues[i]),
+                                                                       static_cast<chip::ClusterId>(clusterValues[i]),
+                                                                       static_cast<chip::AttributeId>(attributeValues[i])),
+                            nullptr,
+                            ChipLogError(Zcl, "updateClusterAttributes: entry %d names an unknown endpoint %d or attribute", i,
+                                         endpointValues[i]));
+    }
+
+    std::vector<jlong> applied((static_cast<size_t>(count) + 63) / 64, 0);
+    size_t unchanged  = 0;
+    jint lastEndpoint = -1;
+    bool endpointLive = false;
+    for (jsize i = 0; i < count; i++)
+    {
+        auto endpoint    = static_cast<chip::EndpointId>(endpointValues[static_cast<size_t>(i)]);
+        auto clusterId   = static_cast<chip::ClusterId>(clusterValues[static_cast<size_t>(i)]);
+        auto attributeId = static_cast<chip::AttributeId>(attributeValues[static_cast<size_t>(i)]);
+
+        // Updates usually come grouped by device
+        if (endpointValues[static_cast<size_t>(i)] != lastEndpoint)
+        {
+            lastEndpoint = endpointValues[static_cast<size_t>(i)];
+            endpointLive = EndpointTable::GetInstance().GetDevice(endpoint) != nullptr;
+        }
+
+        bool changed = true;
+        ByteSpan value(values.data() + offsetValues[static_cast<size_t>(i)],
+                       static_cast<size_t>(offsetValues[static_cast<size_t>(i) + 1] - offsetValues[static_cast<size_t>(i)]));
+        // Not stored (constant, or too large for its slot): neither applied nor reported
+        CHIP_ERROR err = AttributeStore::GetInstance().SetValue(endpoint, clusterId, attributeId, value, &changed);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Zcl, "updateClusterAttributes: entry %d not stored: %" CHIP_ERROR_FORMAT, i, err.Format());
+            continue;
+        }
+
+        applied[static_cast<size_t>(i) / 64] |= static_cast<jlong>(1ull << (static_cast<size_t>(i) % 64));
+        if (endpointLive)
+        {
+            unchanged += changed ? 0 : 1;
+            ReportUpdate(endpoint, clusterId, attributeId, changed);
+        }
+    }
+
+    ChipLogDetail(Zcl, "updateClusterAttributes: %d entries, %u unchanged", count, static_cast<unsigned>(unchanged));
+
+    jlongArray result = env->NewLongArray(static_cast<jsize>(applied.size()));
+    VerifyOrReturnValue(result != nullptr, nullptr, ChipLogError(Zcl, "updateClusterAttributes: NewLongArray failed"));
+    env->SetLongArrayRegion(result, 0, static_cast<jsize>(applied.size()), applied.data());
+    return result;
+}
+
+// Updates from Java dropped because they did not change the stored value
+JNI_METHOD(jlong, getUnchangedUpdateCount)(JNIEnv *, jobject)
+{
+    return static_cast<jlong>(gUnchangedUpdates.load());
+}
+
+// Reportable-change threshold of a numeric attribute: it is reported once it moved by absoluteDelta (attribute
+// units) or relativeDelta (fraction of the last reported value), at most every minIntervalMs, and a smaller change
+// at the latest after maxIntervalMs. All zero turns throttling off for the attribute, including its default.
+JNI_METHOD(void, setReportingThreshold)
+(JNIEnv *, jobject, jint endpoint, jint clusterId, jint attributeId, jlong absoluteDelta, jdouble relativeDelta,
+ jint minIntervalMs, jint maxIntervalMs)
+{
+    ReportThrottle::Threshold threshold;
+    threshold.absoluteDelta = std::max<jlong>(absoluteDelta, 0);
+    threshold.relativeDelta = std::max<jdouble>(relativeDelta, 0);
+    threshold.minIntervalMs = static_cast<uint32_t>(std::max(minIntervalMs, 0));
+    threshold.maxIntervalMs = static_cast<uint32_t>(std::max(maxIntervalMs, 0));
+    ReportThrottle::GetInstance().Configure(static_cast<chip::EndpointId>(endpoint), static_cast<chip::ClusterId>(clusterId),
+                                            static_cast<chip::AttributeId>(attributeId), threshold);
+}
+
+JNI_METHOD(jlongArray, getReportThrottleStats)(JNIEnv * env, jobject)
+{
+    jlong stats[] = { static_cast<jlong>(ReportThrottle::GetInstance().GetSuppressedCount()),
+                      static_cast<jlong>(ReportThrottle::GetInstance().GetDeferredReportCount()) };
+
+    jlongArray array = env->NewLongArray(2);
+    VerifyOrReturnValue(array != nullptr, nullptr, ChipLogError(Zcl, "getReportThrottleStats: NewLongArray failed"));
+    env->SetLongArrayRegion(array, 0, 2, stats);
+    return array;
+}
+
+JNI_METHOD(jlongArray, getEndpointMetadataStats)(JNIEnv * env, jobject)
+{
+    jlong stats[] = { static_cast<jlong>(MetadataArena::GetLiveBytes()), static_cast<jlong>(MetadataArena::GetPeakBytes()),
+                      static_cast<jlong>(MetadataArena::GetLiveArenas()),
+                      static_cast<jlong>(EndpointTemplateRegistry::GetInstance().GetTemplateCount()) };
+
+    jlongArray array = env->NewLongArray(4);
+    VerifyOrReturnValue(array != nullptr, nullptr, ChipLogError(Zcl, "getEndpointMetadataStats: NewLongArray failed"));
+    env->SetLongArrayRegion(array, 0, 4, stats);
+    return array;
+}
+
+// Matter-thread time of adding bridged devices (the publish step after their preparation): { published, failed,
+// total us, max us }
+JNI_METHOD(jlongArray, getPublishStats)(JNIEnv * env, jobject)
+{
+    jlong stats[] = { static_cast<jlong>(gPublishCount.load()), static_cast<jlong>(gPublishFailures.load()),
+                      static_cast<jlong>(gPublishTotalNs.load() / 1000), static_cast<jlong>(gPublishMaxNs.load() / 1000) };
+
+    jlongArray array = env->NewLongArray(4);
+    VerifyOrReturnValue(array != nullptr, nullptr, ChipLogError(Zcl, "getPublishStats: NewLongArray failed"));
+    env->SetLongArrayRegion(array, 0, 4, stats);
+    return array;
+}
+
+// Latency of traced commands and writes on a cluster, in microseconds: { count, p50, p99, max } for each of the
+// dispatch, upcall, until-report, report-queue and total segments. Null if nothing was traced on the cluster.
+JNI_METHOD(jlongArray, getLatencyStats)(JNIEnv * env, jobject, jint clusterId)
+{
+    std::array<LatencyTracer::Summary, static_cast<size_t>(LatencyTracer::Segment::kCount)> summary;
+    VerifyOrReturnValue(LatencyTracer::GetInstance().GetSummary(static_cast<chip::ClusterId>(clusterId), summary), nullptr);
 
+    std::vector<jlong> stats;
+    for (const auto & segment : summary)
+    {
+        stats.insert(stats.end(), { static_cast<jlong>(segment.count), static_cast<jlong>(segment.p50Us),
+                                    static_cast<jlong>(segment.p99Us), static_cast<jlong>(segment.maxUs) });
+    }
+
+    jlongArray array = env->NewLongArray(static_cast<jsize>(stats.size()));
+    VerifyOrReturnValue(array != nullptr, nullptr, ChipLogError(Zcl, "getLatencyStats: NewLongArray failed"));
+    env->SetLongArrayRegion(array, 0, static_cast<jsize>(stats.size()), stats.data());
+    return array;
+}
+
+JNI_METHOD(jstring, dumpLatencyStats)(JNIEnv * env, jobject)
+{
+    return env->NewStringUTF(LatencyTracer::GetInstance().Dump().c_str());
+}
+
+JNI_METHOD(void, setLatencyTracing)(JNIEnv *, jobject, jboolean enabled, jboolean reset)
+{
+    LatencyTracer::GetInstance().SetEnabled(enabled == JNI_TRUE);
+    if (reset == JNI_TRUE)
+    {
+        LatencyTracer::GetInstance().Reset();
+    }
+}
+
+// Reserves count contiguous endpoint IDs, e.g. for the children of a composed device, which are then added with
+// those IDs as requested endpoint. Returns the first ID, or -1 if there is no free range that long.
+JNI_METHOD(jint, reserveEndpointRange)(JNIEnv *, jobject, jint count)
+{
+    VerifyOrReturnValue(count > 0 && count <= UINT16_MAX, -1);
+    chip::EndpointId first = EndpointAllocator::GetInstance().ReserveRange(static_cast<uint16_t>(count));
+    return (first == chip::kInvalidEndpointId) ? -1 : static_cast<jint>(first);
+}
+
+JNI_METHOD(void, releaseEndpointRange)(JNIEnv *, jobject, jint first, jint count)
+{
+    VerifyOrReturn(first >= 0 && first < UINT16_MAX && count > 0 && count <= UINT16_MAX);
+    EndpointAllocator::GetInstance().ReleaseRange(static_cast<chip::EndpointId>(first), static_cast<uint16_t>(count));
+}
+
+// Device state changes reach Java in batches: after flushIntervalMs, or once maxBatchSize attributes changed
+JNI_METHOD(void, setStateChangeBatching)(JNIEnv *, jobject, jint flushIntervalMs, jint maxBatchSize)
+{
+    VerifyOrReturn(flushIntervalMs >= 0 && maxBatchSize > 0, ChipLogError(Zcl, "setStateChangeBatching: invalid arguments"));
+    StateChangeBatcher::GetInstance().Configure(static_cast<uint32_t>(flushIntervalMs), static_cast<size_t>(maxBatchSize));
+}
+
+// Reverts the latest write-behind value of an attribute after Java found it could not apply it
+JNI_METHOD(jboolean, rejectAttributeWrite)(JNIEnv *, jobject, jint endpoint, jint clusterId, jint attributeId)
+{
+    CHIP_ERROR err = WriteBehindQueue::GetInstance().Reject(static_cast<chip::EndpointId>(endpoint),
+                                                           static_cast<chip::ClusterId>(clusterId),
+                                                           static_cast<chip::AttributeId>(attributeId));
+    return (err == CHIP_NO_ERROR) ? JNI_TRUE : JNI_FALSE;
+}
+
+#define BRIDGE_APP_NATIVE(METHOD_NAME, SIGNATURE)                                                                                  \
+    {                                                                                                                              \
+        #METHOD_NAME, SIGNATURE, reinterpret_cast<void *>(Java_com_matter_bridge_app_BridgeApp_##METHOD_NAME)                      \
+    }
+
+// Binds every native of BridgeApp.java explicitly instead of relying on symbol lookup at first call
+static jint RegisterBridgeAppNatives(JavaVM * jvm)
+{
+    JNIEnv * env = nullptr;
+    VerifyOrReturnValue(jvm->GetEnv(reinterpret_cast<void **>(&env), JNI_VERSION_1_6) == JNI_OK, JNI_ERR,
+                        ChipLogError(Zcl, "RegisterBridgeAppNatives: GetEnv failed"));
+
+    jclass bridgeAppClass = env->FindClass("com/matter/bridge/app/BridgeApp");
+    VerifyOrReturnValue(bridgeAppClass != nullptr, JNI_ERR, env->ExceptionClear();
+                        ChipLogError(Zcl, "RegisterBridgeAppNatives: BridgeApp class not found"));
+
+    const JNINativeMethod methods[] = {
+        BRIDGE_APP_NATIVE(nativeInit, "()V"),
+        BRIDGE_APP_NATIVE(preServerInit, "()V"),
+        BRIDGE_APP_NATIVE(postServerInit, "(I)V"),
+        BRIDGE_APP_NATIVE(setDACProvider, "(Lcom/matter/bridge/app/DACProvider;)V"),
+        BRIDGE_APP_NATIVE(getCommissioningQRCode, "()Ljava/lang/String;"),
+        BRIDGE_APP_NATIVE(reportAttributeChange, "(III)V"),
+        BRIDGE_APP_NATIVE(removeBridgedDevice, "(I)Z"),
+        BRIDGE_APP_NATIVE(addBridgedDevice, "(IILjava/lang/String;[I[Lcom/matter/bridge/app/ClusterAttribute;[I)Z"),
+        { "addBridgedDevice", "(IILjava/lang/String;[I[I[I)Z", reinterpret_cast<void *>(AddBridgedDevicePacked) },
+        { "updateClusterAttribute", "(IIIJ)Z", reinterpret_cast<void *>(UpdateClusterAttributeLong) },
+        { "updateClusterAttribute", "(III[B)Z", reinterpret_cast<void *>(UpdateClusterAttributeBytes) },
+        { "updateBool", "(IIIZ)Z", reinterpret_cast<void *>(UpdateBool) },
+        { "updateInt", "(IIIJ)Z", reinterpret_cast<void *>(UpdateInt) },
+        BRIDGE_APP_NATIVE(getAttributeBufferSize, "(I)I"),
+        BRIDGE_APP_NATIVE(attachAttributeBuffer, "(ILjava/nio/ByteBuffer;)Z"),
+        BRIDGE_APP_NATIVE(getAttributeOffset, "(III)I"),
+        BRIDGE_APP_NATIVE(markAttributeDirty, "(ILjava/nio/ByteBuffer;II)I"),
+        BRIDGE_APP_NATIVE(rejectAttributeWrite, "(III)Z"),
+        BRIDGE_APP_NATIVE(setStateChangeBatching, "(II)V"),
+        BRIDGE_APP_NATIVE(getReportQueueStats, "()[J"),
+        BRIDGE_APP_NATIVE(updateClusterAttributes, "([I[I[I[B[I)[J"),
+        BRIDGE_APP_NATIVE(getUnchangedUpdateCount, "()J"),
+        BRIDGE_APP_NATIVE(setReportingThreshold, "(IIIJDII)V"),
+        BRIDGE_APP_NATIVE(registerDeviceTemplate, "([I[Lcom/matter/bridge/app/ClusterAttribute;[I)I"),
+        { "registerDeviceTemplate", "([I[I[I)I", reinterpret_cast<void *>(RegisterDeviceTemplatePacked) },
+        BRIDGE_APP_NATIVE(addBridgedDeviceFromTemplate, "(IIILjava/lang/String;)Z"),
+        BRIDGE_APP_NATIVE(addBridgedDevices, "([Lcom/matter/bridge/app/DeviceSpec;)I"),
+        BRIDGE_APP_NATIVE(setRegistrySnapshotPath, "(Ljava/lang/String;)Z"),
+        BRIDGE_APP_NATIVE(saveRegistrySnapshot, "()Z"),
+        BRIDGE_APP_NATIVE(getPublishStats, "()[J"),
+        BRIDGE_APP_NATIVE(reserveEndpointRange, "(I)I"),
+        BRIDGE_APP_NATIVE(releaseEndpointRange, "(II)V"),
+        BRIDGE_APP_NATIVE(getLatencyStats, "(I)[J"),
+        BRIDGE_APP_NATIVE(dumpLatencyStats, "()Ljava/lang/String;"),
+        BRIDGE_APP_NATIVE(setLatencyTracing, "(ZZ)V"),
+        BRIDGE_APP_NATIVE(getEndpointMetadataStats, "()[J"),
+        BRIDGE_APP_NATIVE(getReportThrottleStats, "()[J"),
+        BRIDGE_APP_NATIVE(getNegativeCacheStats, "()[J"),
+        BRIDGE_APP_NATIVE(getJniAttachStats, "()[J"),
+#if BRIDGE_APP_READ_BENCHMARK
+        BRIDGE_APP_NATIVE(benchmarkReadProtocols, "(IIIII)[J"),
+#endif
+    };
+
+    jint result = env->RegisterNatives(bridgeAppClass, methods, static_cast<jint>(sizeof(methods) / sizeof(methods[0])));
+    env->DeleteLocalRef(bridgeAppClass);
+    VerifyOrReturnValue(result == JNI_OK, JNI_ERR, env->ExceptionClear();
+                        ChipLogError(Zcl, "RegisterBridgeAppNatives: RegisterNatives failed: %d", result));
+
+    ChipLogProgress(Zcl, "Registered BridgeApp natives");
+    return JNI_OK;
+}
 
 // Stub implementations for methods removed from Java but still potentially called by JNI if not cleaned up
 // (Though I cleaned them up in Java, I'll add empty stubs just in case to match the Java file if I missed any)
@@ -18,35 +18,121 @@
 
 #pragma once
 
+#include "StateChangeBatcher.h"
+
+#include <app/ConcreteAttributePath.h>
 #include <jni.h>
 #include <lib/support/JniReferences.h>
 #include <lib/support/JniTypeWrappers.h>
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 class BridgeAppJNI
 {
 public:
     void InitializeWithObjects(jobject app);
     void PostClusterInit(int clusterId, int endpoint);
     void PostEvent(int event);
+    // Queued in the StateChangeBatcher, Java receives it with the next batch
     void PostDeviceStateChanged(int endpoint, int clusterId, int attributeId, uint8_t* value, size_t valueSize);
+    void PostDeviceStateChangedBatch(const StateChangeBatcher::Batch & batch);
+    // Completion of an addBridgedDevices request: the endpoint of each device, -1 for the ones that failed
+    void PostBridgedDevicesAdded(jint requestId, const std::vector<jint> & endpoints, uint64_t elapsedUs);
+    // A device re-created from the registry snapshot at startup, for Kotlin to reattach its handlers
+    struct RestoredDevice
+    {
+        jint endpoint;
+        jint parentEndpoint;
+        std::string name;
+        std::vector<jint> deviceTypeIds;
+        std::vector<jint> clusterIds;
+    };
+    void PostBridgedDevicesRestored(const std::vector<RestoredDevice> & devices, uint64_t elapsedUs);
     
     // Generic cluster attribute handlers (returns nullptr/false if not handled by Java)
     chip::JniByteArray HandleClusterAttributeRead(int endpoint, int clusterId, int attributeId, int maxReadLength);
+    // Direct buffer read: Java writes the value into a direct ByteBuffer reused for every read of the calling thread,
+    // which is then copied into `buffer`. Needs maxReadLength <= kReadBufferSize.
+    int HandleClusterAttributeReadDirect(int endpoint, int clusterId, int attributeId, uint8_t * buffer, uint16_t maxReadLength);
+    // Reads through the direct buffer protocol when possible, through the byte[] one otherwise.
+    // Returns the value length, kReadUnhandled when Java reported the attribute unsupported, kReadUnavailable when it had
+    // no value (a null byte[] answer tells no more), kReadTooLarge when the value does not fit in maxReadLength, or
+    // kReadFailed. Only kReadUnhandled may be cached.
+    int ReadClusterAttribute(int endpoint, int clusterId, int attributeId, uint8_t * buffer, uint16_t maxReadLength);
+    // Batched read: one upcall for many attributes of an endpoint. On success `packed` holds, per requested path and in
+    // order, a little-endian uint16 length followed by the value bytes (0xFFFF when Java does not handle the attribute).
+    bool HandleEndpointAttributesRead(int endpoint, const std::vector<chip::app::ConcreteAttributePath> & paths,
+                                      std::vector<uint8_t> & packed);
     bool HandleClusterAttributeWrite(int endpoint, int clusterId, int attributeId, uint8_t* buffer, size_t bufferSize);
     bool HandleCommand(int endpoint, int clusterId, int commandId);
     void ReportAttributeChange(int endpoint, int clusterId, int attributeId);
 
+    // Field IDs of the device definition classes, resolved once in InitializeWithObjects
+    struct ClusterAttributeFields
+    {
+        jfieldID clusterId    = nullptr;
+        jfieldID attributeId  = nullptr;
+        jfieldID type         = nullptr;
+        jfieldID size         = nullptr;
+        jfieldID mask         = nullptr;
+        jfieldID flags        = nullptr;
+        jfieldID defaultValue = nullptr;
+    };
+
+    struct DeviceSpecFields
+    {
+        jfieldID endpoint         = nullptr;
+        jfieldID parentEndpointId = nullptr;
+        jfieldID name             = nullptr;
+        jfieldID templateId       = nullptr;
+        jfieldID clusterIds       = nullptr;
+        jfieldID attributes       = nullptr;
+        jfieldID deviceTypeIds    = nullptr;
+    };
+
+    // nullptr if the fields could not be resolved
+    const ClusterAttributeFields * GetClusterAttributeFields() const
+    {
+        return mClusterAttributeFieldsResolved ? &mClusterAttributeFields : nullptr;
+    }
+    const DeviceSpecFields * GetDeviceSpecFields() const { return mDeviceSpecFieldsResolved ? &mDeviceSpecFields : nullptr; }
+
     static BridgeAppJNI & GetInstance() { return sInstance; }
 
+    static constexpr int kReadUnhandled       = -1;
+    static constexpr int kReadFailed          = -2;
+    static constexpr int kReadTooLarge        = -3;
+    static constexpr int kReadUnavailable     = -4;
+    static constexpr uint16_t kReadBufferSize = 1024;
+
 private:
     static BridgeAppJNI sInstance;
+
+    void PostDeviceStateChangedSingle(JNIEnv * env, int endpoint, int clusterId, int attributeId, const uint8_t * value,
+                                      size_t valueSize);
+
     chip::JniGlobalReference mDeviceAppObject;
     jmethodID mPostClusterInitMethod = nullptr;
     jmethodID mPostEventMethod       = nullptr;
     jmethodID mPostDeviceStateChangedMethod = nullptr;
+    jmethodID mPostDeviceStateChangedBatchMethod = nullptr;
+    jmethodID mPostBridgedDevicesAddedMethod = nullptr;
+    jmethodID mPostBridgedDevicesRestoredMethod = nullptr;
     jmethodID mOnAttributeReadMethod = nullptr;
+    jmethodID mOnAttributeReadDirectMethod = nullptr;
+    jmethodID mOnEndpointAttributesReadMethod = nullptr;
     jmethodID mOnAttributeWriteMethod = nullptr;
     jmethodID mOnCommandMethod = nullptr;
+
+    // the classes are kept referenced so that their field IDs stay valid
+    chip::JniGlobalReference mClusterAttributeClass;
+    chip::JniGlobalReference mDeviceSpecClass;
+    ClusterAttributeFields mClusterAttributeFields;
+    DeviceSpecFields mDeviceSpecFields;
+    bool mClusterAttributeFieldsResolved = false;
+    bool mDeviceSpecFieldsResolved       = false;
 };
 
 inline class BridgeAppJNI & BridgeAppJNIMgr()
@@ -0,0 +1,174 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "DataVersionStore.h"
+#include "AttributeStore.h"
+#include "EndpointTemplates.h"
+
+#include <crypto/RandUtils.h>
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+
+using namespace chip;
+
+DataVersionStore DataVersionStore::sInstance;
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime  = 1099511628211ull;
+
+uint64_t Mix(uint64_t hash, const uint8_t * data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * kFnvPrime;
+    }
+    return hash;
+}
+
+template <typename T>
+uint64_t Mix(uint64_t hash, T value)
+{
+    uint8_t bytes[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        bytes[i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i));
+    }
+    return Mix(hash, bytes, sizeof(T));
+}
+
+const AttributeStore::AttributeDesc * FindDesc(const EndpointTemplate & endpointTemplate, ClusterId clusterId,
+                                               AttributeId attributeId)
+{
+    for (const auto & desc : endpointTemplate.storeAttributes)
+    {
+        if (desc.clusterId == clusterId && desc.attributeId == attributeId)
+        {
+            return &desc;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void DataVersionStore::Seed(DataVersion * versions, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        versions[i] = Crypto::GetRandU32();
+    }
+}
+
+DataVersionStore::Entry DataVersionStore::Capture(EndpointId endpoint, const EndpointTemplate & endpointTemplate,
+                                                  const DataVersion * versions, AttributeStore::StagingToken staged)
+{
+    Entry entry{ endpoint, {} };
+    std::vector<uint8_t> value;
+
+    for (uint8_t i = 0; i < endpointTemplate.endpointType.clusterCount; i++)
+    {
+        const EmberAfCluster & cluster = endpointTemplate.endpointType.cluster[i];
+        ClusterVersion clusterVersion{ cluster.clusterId, versions[i], kFnvOffset, true };
+
+        for (uint16_t j = 0; j < cluster.attributeCount && clusterVersion.comparable; j++)
+        {
+            AttributeId attributeId                    = cluster.attributes[j].attributeId;
+            const AttributeStore::AttributeDesc * desc = FindDesc(endpointTemplate, cluster.clusterId, attributeId);
+
+            // attributes read from Java may change without the native store knowing
+            CHIP_ERROR err = (staged != AttributeStore::kNoStaging)
+                ? AttributeStore::GetInstance().GetStagedRawValue(staged, cluster.clusterId, attributeId, value)
+                : AttributeStore::GetInstance().GetRawValue(endpoint, cluster.clusterId, attributeId, value);
+            clusterVersion.comparable = desc != nullptr && !(desc->flags & AttributeStore::kFlag_JavaOwned) && err == CHIP_NO_ERROR;
+            if (clusterVersion.comparable)
+            {
+                clusterVersion.fingerprint = Mix(clusterVersion.fingerprint, attributeId);
+                clusterVersion.fingerprint = Mix(clusterVersion.fingerprint, static_cast<uint32_t>(value.size()));
+                clusterVersion.fingerprint = Mix(clusterVersion.fingerprint, value.data(), value.size());
+            }
+        }
+        entry.clusters.push_back(clusterVersion);
+    }
+    return entry;
+}
+
+bool DataVersionStore::Take(EndpointId endpoint, Entry & entry)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mEntries.find(endpoint);
+    VerifyOrReturnValue(it != mEntries.end(), false);
+    entry = Entry{ endpoint, std::move(it->second.clusters) };
+    mEntries.erase(it);
+    return true;
+}
+
+void DataVersionStore::Apply(const Entry & remembered, const EndpointTemplate & endpointTemplate,
+                             AttributeStore::StagingToken values, DataVersion * versions, std::vector<uint8_t> & kept)
+{
+    Entry current = Capture(remembered.endpoint, endpointTemplate, versions, values);
+    for (size_t i = 0; i < current.clusters.size(); i++)
+    {
+        const ClusterVersion & now = current.clusters[i];
+        auto previous = std::find_if(remembered.clusters.begin(), remembered.clusters.end(),
+                                     [&now](const ClusterVersion & cluster) { return cluster.clusterId == now.clusterId; });
+        if (previous == remembered.clusters.end())
+        {
+            continue;
+        }
+
+        bool unchanged = now.comparable && previous->comparable && now.fingerprint == previous->fingerprint;
+        versions[i]    = unchanged ? previous->version : static_cast<DataVersion>(previous->version + 1);
+        if (unchanged)
+        {
+            kept.push_back(static_cast<uint8_t>(i));
+        }
+    }
+}
+
+void DataVersionStore::Remember(EndpointId endpoint, const EndpointTemplate & endpointTemplate, const DataVersion * versions)
+{
+    Remember(Capture(endpoint, endpointTemplate, versions));
+}
+
+void DataVersionStore::Remember(Entry && entry)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    mEntries[entry.endpoint] = Remembered{ mNextSequence++, std::move(entry.clusters) };
+    if (mEntries.size() > kMaxEntries)
+    {
+        auto oldest = std::min_element(mEntries.begin(), mEntries.end(), [](const auto & a, const auto & b) {
+            return a.second.sequence < b.second.sequence;
+        });
+        mEntries.erase(oldest);
+    }
+}
+
+void DataVersionStore::GetEntries(std::vector<Entry> & entries)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    for (const auto & remembered : mEntries)
+    {
+        entries.push_back({ remembered.first, remembered.second.clusters });
+    }
+}
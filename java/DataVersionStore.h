@@ -0,0 +1,95 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "AttributeStore.h"
+
+#include <lib/core/DataModelTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+struct EndpointTemplate;
+
+/**
+ * @brief Cluster DataVersions of bridged devices that went offline, by endpoint ID.
+ *
+ * New devices start from random DataVersions. A device added again at the endpoint it used before continues from
+ * the versions it had there, so that controllers holding DataVersion filters (e.g. resubscribing after a restart)
+ * only read the clusters that changed meanwhile. A cluster keeps its remembered version only if the fingerprint of
+ * its native values is unchanged; otherwise, or if some of its attributes are read from Java, it moves to the next
+ * version.
+ */
+class DataVersionStore
+{
+public:
+    struct ClusterVersion
+    {
+        chip::ClusterId clusterId;
+        chip::DataVersion version;
+        uint64_t fingerprint; // hash of the native attribute values of the cluster
+        bool comparable;      // all attributes of the cluster are native, so the fingerprint covers its whole state
+    };
+
+    struct Entry
+    {
+        chip::EndpointId endpoint;
+        std::vector<ClusterVersion> clusters;
+    };
+
+    static DataVersionStore & GetInstance() { return sInstance; }
+
+    // Random initial versions, for the storage of a device being prepared
+    static void Seed(chip::DataVersion * versions, size_t count);
+    // Versions and fingerprints of a device whose values are in the AttributeStore, live or staged under `staged`
+    static Entry Capture(chip::EndpointId endpoint, const EndpointTemplate & endpointTemplate, const chip::DataVersion * versions,
+                         AttributeStore::StagingToken staged = AttributeStore::kNoStaging);
+
+    // Removes and returns the versions remembered for endpoint, when a device is being prepared for it
+    bool Take(chip::EndpointId endpoint, Entry & entry);
+    // Called while a device is prepared for endpoint, with its initial values staged: overrides the seeded versions of
+    // the clusters in remembered. `kept` receives the indices of the clusters that kept their remembered version;
+    // they must move on if a value changes before the endpoint goes live (see AttributeStore::GetStagedGeneration).
+    static void Apply(const Entry & remembered, const EndpointTemplate & endpointTemplate, AttributeStore::StagingToken values,
+                      chip::DataVersion * versions, std::vector<uint8_t> & kept);
+    // Called before a device is removed, while its values are still in the AttributeStore
+    void Remember(chip::EndpointId endpoint, const EndpointTemplate & endpointTemplate, const chip::DataVersion * versions);
+    void Remember(Entry && entry);
+
+    // Entries of the devices that are offline, for the registry snapshot
+    void GetEntries(std::vector<Entry> & entries);
+
+private:
+    static DataVersionStore sInstance;
+
+    static constexpr size_t kMaxEntries = 1024;
+
+    struct Remembered
+    {
+        uint64_t sequence; // the oldest entry is evicted first
+        std::vector<ClusterVersion> clusters;
+    };
+
+    std::mutex mLock;
+    std::map<chip::EndpointId, Remembered> mEntries;
+    uint64_t mNextSequence = 0;
+};
@@ -0,0 +1,196 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "EndpointAllocator.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceConfig.h>
+
+#include <algorithm>
+
+using namespace chip;
+
+EndpointAllocator EndpointAllocator::sInstance;
+
+EndpointAllocator::EndpointAllocator()
+{
+    mFreeSlots.reserve(CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT);
+    for (size_t slot = CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT; slot > 0; slot--)
+    {
+        mFreeSlots.push_back(static_cast<uint16_t>(slot - 1));
+    }
+    MarkUsed(kInvalidEndpointId);
+}
+
+void EndpointAllocator::Init(EndpointId firstDynamicEndpoint)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    for (size_t id = 0; id < firstDynamicEndpoint; id++)
+    {
+        MarkUsed(id);
+    }
+    mFirst  = firstDynamicEndpoint;
+    mCursor = std::max<size_t>(mCursor, firstDynamicEndpoint);
+}
+
+int EndpointAllocator::AllocateSlot()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnValue(!mFreeSlots.empty(), -1);
+    uint16_t slot = mFreeSlots.back();
+    mFreeSlots.pop_back();
+    return slot;
+}
+
+void EndpointAllocator::ReleaseSlot(uint16_t slot)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    mFreeSlots.push_back(slot);
+}
+
+void EndpointAllocator::MarkUsed(size_t id)
+{
+    size_t word = id / 64;
+    mUsed[word] |= 1ull << (id % 64);
+    if (mUsed[word] == UINT64_MAX)
+    {
+        mFullWords[word / 64] |= 1ull << (word % 64);
+    }
+}
+
+void EndpointAllocator::ClearUsed(size_t id)
+{
+    size_t word = id / 64;
+    mUsed[word] &= ~(1ull << (id % 64));
+    mFullWords[word / 64] &= ~(1ull << (word % 64));
+}
+
+size_t EndpointAllocator::FindFree(size_t from) const
+{
+    VerifyOrReturnValue(from < kIdCount, kIdCount);
+
+    size_t word   = from / 64;
+    uint64_t free = ~mUsed[word] & (UINT64_MAX << (from % 64));
+    if (free != 0)
+    {
+        return word * 64 + static_cast<size_t>(__builtin_ctzll(free));
+    }
+
+    // Skip full words through the summary bitmap
+    for (size_t next = word + 1; next < kWordCount;)
+    {
+        uint64_t notFull = ~mFullWords[next / 64] & (UINT64_MAX << (next % 64));
+        if (notFull != 0)
+        {
+            size_t candidate = (next / 64) * 64 + static_cast<size_t>(__builtin_ctzll(notFull));
+            return candidate * 64 + static_cast<size_t>(__builtin_ctzll(~mUsed[candidate]));
+        }
+        next = (next / 64 + 1) * 64;
+    }
+    return kIdCount;
+}
+
+EndpointId EndpointAllocator::Allocate()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    size_t id = FindFree(mCursor);
+    if (id == kIdCount)
+    {
+        // Wrap around to the first dynamic endpoint
+        id = FindFree(mFirst);
+    }
+    VerifyOrReturnValue(id < kIdCount, kInvalidEndpointId, ChipLogError(Zcl, "EndpointAllocator: no endpoint ID left"));
+
+    MarkUsed(id);
+    mCursor = id + 1;
+    return static_cast<EndpointId>(id);
+}
+
+bool EndpointAllocator::Claim(EndpointId endpoint)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnValue(endpoint >= mFirst && endpoint != kInvalidEndpointId, false);
+    if (IsReserved(endpoint))
+    {
+        mReserved[endpoint / 64] &= ~(1ull << (endpoint % 64));
+        return true;
+    }
+    VerifyOrReturnValue(!IsUsed(endpoint), false);
+    MarkUsed(endpoint);
+    return true;
+}
+
+void EndpointAllocator::Release(EndpointId endpoint)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturn(endpoint >= mFirst && endpoint != kInvalidEndpointId);
+    mReserved[endpoint / 64] &= ~(1ull << (endpoint % 64));
+    ClearUsed(endpoint);
+}
+
+EndpointId EndpointAllocator::ReserveRange(uint16_t count)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnValue(count > 0, kInvalidEndpointId);
+
+    size_t start = FindFree(mFirst);
+    while (start < kIdCount)
+    {
+        size_t end = start + 1;
+        while (end < kIdCount && end - start < count && !IsUsed(end))
+        {
+            end++;
+        }
+        if (end - start == count)
+        {
+            for (size_t id = start; id < end; id++)
+            {
+                MarkUsed(id);
+                mReserved[id / 64] |= 1ull << (id % 64);
+            }
+            ChipLogProgress(Zcl, "EndpointAllocator: reserved endpoints %u..%u", static_cast<unsigned>(start),
+                            static_cast<unsigned>(end - 1));
+            return static_cast<EndpointId>(start);
+        }
+        start = FindFree(end);
+    }
+    ChipLogError(Zcl, "EndpointAllocator: no range of %u free endpoint IDs", count);
+    return kInvalidEndpointId;
+}
+
+void EndpointAllocator::ReleaseRange(EndpointId first, uint16_t count)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    for (size_t id = first; id < static_cast<size_t>(first) + count && id < kIdCount; id++)
+    {
+        if (IsReserved(id))
+        {
+            mReserved[id / 64] &= ~(1ull << (id % 64));
+            ClearUsed(id);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Hands out dynamic endpoint slots and endpoint IDs for AddDeviceEndpoint.
+ *
+ * Free slots of gDevices / the ember dynamic endpoint table are kept on a stack. Endpoint IDs are tracked in a bitmap
+ * with a second-level bitmap of full words, so finding a free ID takes a few find-first-zero steps however
+ * fragmented the ID space is. IDs are handed out next-fit from the last allocation, like the former
+ * gCurrentEndpointId counter, so a removed endpoint's ID is not immediately reused.
+ *
+ * Contiguous ID ranges can be reserved, e.g. for the children of a composed device: reserved IDs are skipped by
+ * Allocate and become used when a device is added with one of them as requested endpoint ID.
+ */
+class EndpointAllocator
+{
+public:
+    static EndpointAllocator & GetInstance() { return sInstance; }
+
+    // IDs below firstDynamicEndpoint belong to static endpoints and are never handed out
+    void Init(chip::EndpointId firstDynamicEndpoint);
+
+    // a free slot, the most recently released one first (slots start out in ascending order); -1 if all are in use
+    int AllocateSlot();
+    void ReleaseSlot(uint16_t slot);
+
+    // next free ID, kInvalidEndpointId if none is left
+    chip::EndpointId Allocate();
+    // takes a requested ID: free or reserved IDs succeed, IDs in use fail
+    bool Claim(chip::EndpointId endpoint);
+    void Release(chip::EndpointId endpoint);
+
+    // first ID of `count` contiguous free IDs now reserved, kInvalidEndpointId if there is no such range
+    chip::EndpointId ReserveRange(uint16_t count);
+    // frees the IDs of a range that were not claimed
+    void ReleaseRange(chip::EndpointId first, uint16_t count);
+
+private:
+    static constexpr size_t kIdCount      = static_cast<size_t>(UINT16_MAX) + 1;
+    static constexpr size_t kWordCount    = kIdCount / 64;
+    static constexpr size_t kSummaryCount = kWordCount / 64;
+
+    static EndpointAllocator sInstance;
+
+    EndpointAllocator();
+
+    bool IsUsed(size_t id) const { return (mUsed[id / 64] >> (id % 64)) & 1; }
+    bool IsReserved(size_t id) const { return (mReserved[id / 64] >> (id % 64)) & 1; }
+    void MarkUsed(size_t id);
+    void ClearUsed(size_t id);
+    // first free ID in [from, kIdCount), kIdCount if there is none
+    size_t FindFree(size_t from) const;
+
+    std::mutex mLock;
+    std::vector<uint16_t> mFreeSlots; // LIFO: released slots are handed out again first
+    std::array<uint64_t, kWordCount> mUsed{};
+    std::array<uint64_t, kSummaryCount> mFullWords{}; // bit per mUsed word, set when the word has no free ID
+    std::array<uint64_t, kWordCount> mReserved{};
+    chip::EndpointId mFirst = 0;
+    size_t mCursor          = 0; // next-fit start
+};
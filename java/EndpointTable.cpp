@@ -0,0 +1,78 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "EndpointTable.h"
+
+#include <lib/support/CodeUtils.h>
+
+using namespace chip;
+
+EndpointTable EndpointTable::sInstance;
+
+EndpointTable::Slot * EndpointTable::GetSlot(EndpointId endpoint, bool create)
+{
+    std::atomic<Page *> & pageRef = mPages[endpoint >> kPageBits];
+    Page * page                   = pageRef.load(std::memory_order_acquire);
+    if (page == nullptr)
+    {
+        VerifyOrReturnValue(create, nullptr);
+        // Only the Matter thread creates pages, readers see either nullptr or the complete page
+        page = new Page();
+        pageRef.store(page, std::memory_order_release);
+    }
+    return &(*page)[endpoint & (kPageSize - 1)];
+}
+
+void EndpointTable::Insert(EndpointId endpoint, uint16_t slot, Device * device)
+{
+    Slot * entry = GetSlot(endpoint, true);
+    entry->slot.store(slot, std::memory_order_relaxed);
+    entry->type.store(DeviceType::Unknown, std::memory_order_relaxed);
+    // publishes slot and type along with the device
+    entry->device.store(device, std::memory_order_release);
+}
+
+void EndpointTable::SetType(EndpointId endpoint, DeviceType type)
+{
+    Slot * entry = GetSlot(endpoint, false);
+    VerifyOrReturn(entry != nullptr);
+    entry->type.store(type, std::memory_order_relaxed);
+}
+
+void EndpointTable::Remove(EndpointId endpoint)
+{
+    Slot * entry = GetSlot(endpoint, false);
+    VerifyOrReturn(entry != nullptr);
+    entry->device.store(nullptr, std::memory_order_release);
+    entry->slot.store(kInvalidSlot, std::memory_order_relaxed);
+    entry->type.store(DeviceType::Unknown, std::memory_order_relaxed);
+}
+
+EndpointTable::Entry EndpointTable::Find(EndpointId endpoint) const
+{
+    Entry result;
+    Page * page = mPages[endpoint >> kPageBits].load(std::memory_order_acquire);
+    VerifyOrReturnValue(page != nullptr, result);
+
+    const Slot & entry = (*page)[endpoint & (kPageSize - 1)];
+    result.device      = entry.device.load(std::memory_order_acquire);
+    VerifyOrReturnValue(result.device != nullptr, Entry());
+    result.slot = entry.slot.load(std::memory_order_relaxed);
+    result.type = entry.type.load(std::memory_order_relaxed);
+    return result;
+}
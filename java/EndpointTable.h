@@ -0,0 +1,93 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "Device.h"
+
+#include <lib/core/DataModelTypes.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Device type tracking (since RTTI is disabled)
+enum class DeviceType : uint8_t
+{
+    Unknown,
+    OnOff,
+    TempSensor,
+    OnOffLightSwitch,
+    Generic // New generic type
+};
+
+/**
+ * @brief Direct-mapped EndpointId -> bridged device table.
+ *
+ * Answers "which dynamic endpoint slot and device serve this endpoint" in constant time, independent of the number of
+ * bridged devices, where emberAfGetDynamicIndexFromEndpoint scans every dynamic endpoint. The table is split into
+ * 256-entry pages allocated the first time an endpoint in their range is used, so it stays small for the usual dense
+ * endpoint numbering.
+ *
+ * Entries are only changed on the Matter thread (AddDeviceEndpoint / RemoveDeviceEndpoint) but can be looked up from
+ * any thread.
+ */
+class EndpointTable
+{
+public:
+    static constexpr uint16_t kInvalidSlot = 0xFFFF;
+
+    struct Entry
+    {
+        uint16_t slot   = kInvalidSlot; // index in gDevices and in the ember dynamic endpoint table
+        Device * device = nullptr;
+        DeviceType type = DeviceType::Unknown;
+    };
+
+    static EndpointTable & GetInstance() { return sInstance; }
+
+    void Insert(chip::EndpointId endpoint, uint16_t slot, Device * device);
+    void SetType(chip::EndpointId endpoint, DeviceType type);
+    void Remove(chip::EndpointId endpoint);
+
+    // device == nullptr if no bridged device is live on the endpoint
+    Entry Find(chip::EndpointId endpoint) const;
+    Device * GetDevice(chip::EndpointId endpoint) const { return Find(endpoint).device; }
+
+private:
+    static constexpr size_t kPageBits  = 8;
+    static constexpr size_t kPageSize  = 1u << kPageBits;
+    static constexpr size_t kPageCount = (static_cast<size_t>(UINT16_MAX) + 1) / kPageSize;
+
+    struct Slot
+    {
+        std::atomic<Device *> device{ nullptr };
+        std::atomic<uint16_t> slot{ kInvalidSlot };
+        std::atomic<DeviceType> type{ DeviceType::Unknown };
+    };
+
+    using Page = std::array<Slot, kPageSize>;
+
+    static EndpointTable sInstance;
+
+    Slot * GetSlot(chip::EndpointId endpoint, bool create);
+
+    // pages live as long as the process, so a lookup never races with a page being freed
+    std::array<std::atomic<Page *>, kPageCount> mPages{};
+};
@@ -0,0 +1,268 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "EndpointTemplates.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <cinttypes>
+#include <memory>
+
+using namespace chip;
+
+EndpointTemplateRegistry EndpointTemplateRegistry::sInstance;
+
+namespace {
+
+template <typename T>
+void Append(std::vector<uint8_t> & out, T value)
+{
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        out.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+    }
+}
+
+uint64_t HashOf(const std::vector<uint8_t> & bytes)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (uint8_t byte : bytes)
+    {
+        hash = (hash ^ byte) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+std::vector<uint8_t> EndpointTemplateRegistry::Signature(const EndpointDefinition & definition)
+{
+    std::vector<uint8_t> signature;
+
+    Append(signature, definition.clusters.size());
+    for (size_t i = 0; i < definition.clusters.size(); i++)
+    {
+        const EmberAfCluster & cluster = definition.clusters[i];
+        Append(signature, cluster.clusterId);
+        Append(signature, cluster.mask);
+        Append(signature, reinterpret_cast<uintptr_t>(cluster.acceptedCommandList));
+        Append(signature, definition.attributes[i].size());
+        for (const auto & attribute : definition.attributes[i])
+        {
+            Append(signature, attribute.attributeId);
+            Append(signature, attribute.size);
+            Append(signature, attribute.attributeType);
+            Append(signature, attribute.mask);
+        }
+    }
+
+    Append(signature, definition.deviceTypes.size());
+    for (const auto & deviceType : definition.deviceTypes)
+    {
+        Append(signature, deviceType.deviceTypeId);
+        Append(signature, deviceType.deviceVersion);
+    }
+
+    Append(signature, definition.storeAttributes.size());
+    for (const auto & desc : definition.storeAttributes)
+    {
+        Append(signature, desc.clusterId);
+        Append(signature, desc.attributeId);
+        Append(signature, desc.flags);
+        Append(signature, desc.defaultValue.size());
+        signature.insert(signature.end(), desc.defaultValue.begin(), desc.defaultValue.end());
+    }
+    return signature;
+}
+
+std::unique_ptr<EndpointTemplate> EndpointTemplateRegistry::Build(EndpointDefinition && definition)
+{
+    VerifyOrReturnValue(definition.clusters.size() == definition.attributes.size(), nullptr);
+
+    std::unique_ptr<EndpointTemplate> endpointTemplate(new EndpointTemplate());
+    MetadataArena & arena = endpointTemplate->arena;
+
+    size_t attributeCount = 0;
+    for (const auto & attributes : definition.attributes)
+    {
+        attributeCount += attributes.size();
+    }
+    arena.Reserve<EmberAfCluster>(definition.clusters.size());
+    arena.Reserve<EmberAfAttributeMetadata>(attributeCount);
+    arena.Reserve<EmberAfDeviceType>(definition.deviceTypes.size());
+    VerifyOrReturnValue(arena.Init(), nullptr);
+
+    EmberAfCluster * clusters             = arena.Allocate<EmberAfCluster>(definition.clusters.size());
+    EmberAfAttributeMetadata * attributes = arena.Allocate<EmberAfAttributeMetadata>(attributeCount);
+    EmberAfDeviceType * deviceTypes       = arena.Allocate<EmberAfDeviceType>(definition.deviceTypes.size());
+
+    std::uninitialized_copy(definition.clusters.begin(), definition.clusters.end(), clusters);
+    for (size_t i = 0; i < definition.clusters.size(); i++)
+    {
+        const auto & clusterAttributes = definition.attributes[i];
+        std::uninitialized_copy(clusterAttributes.begin(), clusterAttributes.end(), attributes);
+        clusters[i].attributes     = attributes;
+        clusters[i].attributeCount = static_cast<uint16_t>(clusterAttributes.size());
+        attributes += clusterAttributes.size();
+    }
+    std::uninitialized_copy(definition.deviceTypes.begin(), definition.deviceTypes.end(), deviceTypes);
+
+    endpointTemplate->endpointType.cluster      = clusters;
+    endpointTemplate->endpointType.clusterCount = static_cast<uint8_t>(definition.clusters.size());
+    endpointTemplate->endpointType.endpointSize = 0;
+    endpointTemplate->deviceTypes               = chip::Span<const EmberAfDeviceType>(deviceTypes, definition.deviceTypes.size());
+    endpointTemplate->storeAttributes           = std::move(definition.storeAttributes);
+    return endpointTemplate;
+}
+
+EndpointDefinition EndpointTemplate::ToDefinition() const
+{
+    EndpointDefinition definition;
+    for (uint8_t i = 0; i < endpointType.clusterCount; i++)
+    {
+        const EmberAfCluster & cluster = endpointType.cluster[i];
+        definition.clusters.push_back(cluster);
+        definition.clusters.back().attributes     = nullptr;
+        definition.clusters.back().attributeCount = 0;
+        definition.attributes.emplace_back(cluster.attributes, cluster.attributes + cluster.attributeCount);
+    }
+    definition.deviceTypes.assign(deviceTypes.begin(), deviceTypes.end());
+    definition.storeAttributes = storeAttributes;
+    return definition;
+}
+
+EndpointTemplateRegistry::Registered * EndpointTemplateRegistry::InternLocked(EndpointDefinition && definition)
+{
+    std::vector<uint8_t> signature = Signature(definition);
+    uint64_t hash                  = HashOf(signature);
+
+    auto range = mBySignatureHash.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        Registered & registered = mTemplates[it->second];
+        if (registered.signature == signature)
+        {
+            mSharedCount++;
+            return &registered;
+        }
+    }
+
+    std::unique_ptr<EndpointTemplate> endpointTemplate = Build(std::move(definition));
+    VerifyOrReturnValue(endpointTemplate != nullptr, nullptr,
+                        ChipLogError(Zcl, "EndpointTemplateRegistry: failed to allocate endpoint metadata"));
+
+    uint32_t id          = mNextId++;
+    endpointTemplate->id = id;
+    ChipLogProgress(Zcl, "EndpointTemplateRegistry: registered template %" PRIu32 " (%u clusters, %u bytes)", id,
+                    static_cast<unsigned>(endpointTemplate->endpointType.clusterCount),
+                    static_cast<unsigned>(endpointTemplate->arena.GetSize()));
+
+    Registered & registered = mTemplates[id];
+    registered              = Registered{ std::move(endpointTemplate), std::move(signature), hash, 0, false };
+    mBySignatureHash.emplace(hash, id);
+    return &registered;
+}
+
+const EndpointTemplate * EndpointTemplateRegistry::Acquire(EndpointDefinition && definition)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Registered * registered = InternLocked(std::move(definition));
+    VerifyOrReturnValue(registered != nullptr, nullptr);
+    registered->devices++;
+    return registered->endpointTemplate.get();
+}
+
+const EndpointTemplate * EndpointTemplateRegistry::Acquire(uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mTemplates.find(id);
+    VerifyOrReturnValue(it != mTemplates.end() && it->second.pinned, nullptr);
+    it->second.devices++;
+    return it->second.endpointTemplate.get();
+}
+
+const EndpointTemplate * EndpointTemplateRegistry::Acquire(const EndpointTemplate * endpointTemplate)
+{
+    VerifyOrReturnValue(endpointTemplate != nullptr, nullptr);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mTemplates.find(endpointTemplate->id);
+    VerifyOrReturnValue(it != mTemplates.end() && (it->second.devices > 0 || it->second.pinned), nullptr);
+    it->second.devices++;
+    return it->second.endpointTemplate.get();
+}
+
+uint32_t EndpointTemplateRegistry::Register(EndpointDefinition && definition)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Registered * registered = InternLocked(std::move(definition));
+    VerifyOrReturnValue(registered != nullptr, kInvalidTemplate);
+    registered->pinned = true;
+    return registered->endpointTemplate->id;
+}
+
+void EndpointTemplateRegistry::Release(const EndpointTemplate * endpointTemplate)
+{
+    VerifyOrReturn(endpointTemplate != nullptr);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mTemplates.find(endpointTemplate->id);
+    VerifyOrReturn(it != mTemplates.end() && it->second.devices > 0);
+    Registered & registered = it->second;
+    VerifyOrReturn(--registered.devices == 0 && !registered.pinned);
+
+    auto range = mBySignatureHash.equal_range(registered.hash);
+    for (auto hashIt = range.first; hashIt != range.second; ++hashIt)
+    {
+        if (hashIt->second == it->first)
+        {
+            mBySignatureHash.erase(hashIt);
+            break;
+        }
+    }
+    ChipLogProgress(Zcl, "EndpointTemplateRegistry: released template %" PRIu32, it->first);
+    mTemplates.erase(it);
+}
+
+bool EndpointTemplateRegistry::IsRegistered(const EndpointTemplate * endpointTemplate)
+{
+    VerifyOrReturnValue(endpointTemplate != nullptr, false);
+
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mTemplates.find(endpointTemplate->id);
+    return it != mTemplates.end() && it->second.pinned;
+}
+
+size_t EndpointTemplateRegistry::GetTemplateCount()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mTemplates.size();
+}
+
+uint64_t EndpointTemplateRegistry::GetSharedCount()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mSharedCount;
+}
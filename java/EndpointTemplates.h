@@ -0,0 +1,118 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "AttributeStore.h"
+#include "MetadataArena.h"
+
+#include <app/util/af-types.h>
+#include <app/util/attribute-storage.h>
+#include <lib/support/Span.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Normalized endpoint definition, as built from a device schema before it is interned
+struct EndpointDefinition
+{
+    // attributes/attributeCount of each cluster are set when the definition is laid out in a template
+    std::vector<EmberAfCluster> clusters;
+    std::vector<std::vector<EmberAfAttributeMetadata>> attributes; // per cluster, same order as clusters
+    std::vector<EmberAfDeviceType> deviceTypes;
+    std::vector<AttributeStore::AttributeDesc> storeAttributes;
+};
+
+/**
+ * @brief Endpoint definition (clusters, attribute metadata, device types and native store layout) shared by every
+ * bridged device built from the same schema.
+ *
+ * Clusters, attributes and device types are laid out in one MetadataArena block; endpointType and deviceTypes point
+ * into it, so a template is never moved or copied once registered.
+ */
+struct EndpointTemplate
+{
+    uint32_t id = 0;
+    EmberAfEndpointType endpointType;
+    chip::Span<const EmberAfDeviceType> deviceTypes;
+    std::vector<AttributeStore::AttributeDesc> storeAttributes;
+    MetadataArena arena;
+
+    // copy of the definition the template was built from
+    EndpointDefinition ToDefinition() const;
+};
+
+/**
+ * @brief Interns endpoint templates by their normalized definition.
+ *
+ * Devices with byte-identical definitions (e.g. all lights created by DeviceFactory) reference a single template and
+ * only own their DataVersion storage. Each device holds a reference on its template: templates registered by ID
+ * (registerDeviceTemplate) stay for the lifetime of the process, the others are released with their last device.
+ */
+class EndpointTemplateRegistry
+{
+public:
+    static constexpr uint32_t kInvalidTemplate = 0;
+
+    static EndpointTemplateRegistry & GetInstance() { return sInstance; }
+
+    // Interns the definition and takes a device reference on its template; nullptr if out of memory
+    const EndpointTemplate * Acquire(EndpointDefinition && definition);
+    // Takes a device reference on a template registered by ID; nullptr if the ID is unknown
+    const EndpointTemplate * Acquire(uint32_t id);
+    // Takes another device reference on a template the caller already holds one on, or that is registered by ID
+    const EndpointTemplate * Acquire(const EndpointTemplate * endpointTemplate);
+    // Interns the definition and keeps its template for the lifetime of the process; returns kInvalidTemplate if out of memory
+    uint32_t Register(EndpointDefinition && definition);
+    // Drops a device reference, after the device's endpoint was cleared
+    void Release(const EndpointTemplate * endpointTemplate);
+    // Whether the template was registered by ID, and so outlives its devices
+    bool IsRegistered(const EndpointTemplate * endpointTemplate);
+
+    size_t GetTemplateCount();
+    // Acquire/Register calls answered with an existing template
+    uint64_t GetSharedCount();
+
+private:
+    static EndpointTemplateRegistry sInstance;
+
+    struct Registered
+    {
+        std::unique_ptr<EndpointTemplate> endpointTemplate;
+        std::vector<uint8_t> signature;
+        uint64_t hash;
+        uint32_t devices; // device references
+        bool pinned;      // registered by ID
+    };
+
+    static std::vector<uint8_t> Signature(const EndpointDefinition & definition);
+    // lays out the ember structures of a definition in a single arena block
+    static std::unique_ptr<EndpointTemplate> Build(EndpointDefinition && definition);
+
+    Registered * InternLocked(EndpointDefinition && definition);
+
+    std::mutex mLock;
+    std::map<uint32_t, Registered> mTemplates;
+    std::unordered_multimap<uint64_t, uint32_t> mBySignatureHash;
+    uint32_t mNextId      = kInvalidTemplate + 1;
+    uint64_t mSharedCount = 0;
+};
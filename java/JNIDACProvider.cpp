@@ -16,6 +16,7 @@
  */
 
 #include "JNIDACProvider.h"
+#include "JniEnvCache.h"
 #include "lib/support/logging/CHIPLogging.h"
 #include <credentials/CHIPCert.h>
 #include <crypto/CHIPCryptoPAL.h>
@@ -31,8 +32,8 @@ using namespace chip;
 
 JNIDACProvider::JNIDACProvider(jobject provider)
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
-    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "Failed to GetEnvForCurrentThread for JNIDACProvider"));
+    JNIEnv * env = JniEnvCache::GetEnv();
+    VerifyOrReturn(env != nullptr, ChipLogError(Zcl, "Failed to get JNIEnv for JNIDACProvider"));
     VerifyOrReturn(mJNIDACProviderObject.Init(provider) == CHIP_NO_ERROR,
                    ChipLogError(Zcl, "Failed to Init mJNIDACProviderObject"));
 
@@ -86,7 +87,7 @@ JNIDACProvider::JNIDACProvider(jobject provider)
 
 CHIP_ERROR JNIDACProvider::GetJavaByteByMethod(jmethodID method, MutableByteSpan & out_buffer)
 {
-    JNIEnv * env = JniReferences::GetInstance().GetEnvForCurrentThread();
+    JNIEnv * env = JniEnvCache::GetEnv();
     VerifyOrReturnLogError(mJNIDACProviderObject.HasValidObjectRef(), CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnLogError(method != nullptr, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnLogError(env != nullptr, CHIP_JNI_ERROR_NO_ENV);
@@ -0,0 +1,101 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "JniEnvCache.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/JniReferences.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <atomic>
+#include <pthread.h>
+
+using namespace chip;
+
+namespace {
+
+thread_local JNIEnv * tEnv = nullptr;
+
+std::atomic<uint64_t> gAttachCount{ 0 };
+std::atomic<uint64_t> gDetachCount{ 0 };
+
+pthread_key_t gDetachKey;
+pthread_once_t gDetachKeyOnce = PTHREAD_ONCE_INIT;
+bool gDetachKeyValid          = false;
+
+// Runs at exit of every thread this cache attached; the key value is the VM the thread was attached to
+void DetachThread(void * vm)
+{
+    tEnv = nullptr;
+    if (static_cast<JavaVM *>(vm)->DetachCurrentThread() == JNI_OK)
+    {
+        gDetachCount++;
+    }
+}
+
+void CreateDetachKey()
+{
+    gDetachKeyValid = (pthread_key_create(&gDetachKey, DetachThread) == 0);
+}
+
+} // anonymous namespace
+
+JNIEnv * JniEnvCache::GetEnv()
+{
+    if (tEnv != nullptr)
+    {
+        return tEnv;
+    }
+
+    JavaVM * vm = JniReferences::GetInstance().GetJavaVm();
+    VerifyOrReturnValue(vm != nullptr, nullptr, ChipLogError(Zcl, "JniEnvCache: no JavaVM"));
+
+    JNIEnv * env = nullptr;
+    jint status  = vm->GetEnv(reinterpret_cast<void **>(&env), JNI_VERSION_1_6);
+    if (status == JNI_EDETACHED)
+    {
+        pthread_once(&gDetachKeyOnce, CreateDetachKey);
+        // Without a detach hook the thread would leak its VM attachment on exit
+        VerifyOrReturnValue(gDetachKeyValid, nullptr, ChipLogError(Zcl, "JniEnvCache: failed to create thread key"));
+
+#ifdef __ANDROID__
+        status = vm->AttachCurrentThreadAsDaemon(&env, nullptr);
+#else
+        status = vm->AttachCurrentThreadAsDaemon(reinterpret_cast<void **>(&env), nullptr);
+#endif
+        VerifyOrReturnValue(status == JNI_OK, nullptr, ChipLogError(Zcl, "JniEnvCache: AttachCurrentThread failed: %d", status));
+
+        pthread_setspecific(gDetachKey, vm);
+        gAttachCount++;
+        ChipLogDetail(Zcl, "JniEnvCache: attached thread to the VM");
+    }
+    VerifyOrReturnValue(status == JNI_OK && env != nullptr, nullptr, ChipLogError(Zcl, "JniEnvCache: GetEnv failed: %d", status));
+
+    tEnv = env;
+    return env;
+}
+
+uint64_t JniEnvCache::GetAttachCount()
+{
+    return gAttachCount;
+}
+
+uint64_t JniEnvCache::GetDetachCount()
+{
+    return gDetachCount;
+}
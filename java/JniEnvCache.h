@@ -0,0 +1,41 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#include <cstdint>
+
+/**
+ * @brief Per-thread JNIEnv cache for upcalls into Java.
+ *
+ * The first call on a thread looks the JNIEnv up (attaching the thread to the VM as a daemon if needed) and keeps it
+ * in a thread_local, so later upcalls from that thread, typically the Matter event loop, cost a single load.
+ * Threads attached here stay attached for their whole life and are detached by a pthread key destructor on exit.
+ */
+class JniEnvCache
+{
+public:
+    // JNIEnv of the calling thread, nullptr if the VM is not available yet or attaching failed
+    static JNIEnv * GetEnv();
+
+    // number of threads attached to / detached from the VM by this cache since load
+    static uint64_t GetAttachCount();
+    static uint64_t GetDetachCount();
+};
@@ -0,0 +1,319 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "LatencyTracer.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+using namespace chip;
+
+LatencyTracer LatencyTracer::sInstance;
+
+namespace {
+
+constexpr uint8_t StageBit(LatencyTracer::Stage stage)
+{
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(stage));
+}
+
+const char * SegmentName(size_t segment)
+{
+    static const char * const kNames[] = { "dispatch", "upcall", "until-report", "report-queue", "total" };
+    return kNames[segment];
+}
+
+} // namespace
+
+size_t LatencyTracer::Histogram::BucketOf(uint64_t us)
+{
+    if (us < kLinearBuckets)
+    {
+        return static_cast<size_t>(us);
+    }
+    unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(us));
+    size_t sub        = static_cast<size_t>(us >> (exponent - 3)) & (kSubBuckets - 1);
+    return kLinearBuckets + (exponent - 4) * kSubBuckets + sub;
+}
+
+uint64_t LatencyTracer::Histogram::UpperBoundOf(size_t bucket)
+{
+    if (bucket < kLinearBuckets)
+    {
+        return bucket;
+    }
+    unsigned exponent = static_cast<unsigned>((bucket - kLinearBuckets) / kSubBuckets) + 4;
+    uint64_t sub      = (bucket - kLinearBuckets) % kSubBuckets;
+    uint64_t width    = 1ull << (exponent - 3);
+    return (kSubBuckets + sub) * width + width - 1;
+}
+
+void LatencyTracer::Histogram::Record(uint64_t us)
+{
+    mBuckets[BucketOf(us)]++;
+    mCount++;
+    mMax = std::max(mMax, us);
+}
+
+uint64_t LatencyTracer::FilterBit(EndpointId endpoint, ClusterId clusterId)
+{
+    uint64_t hash = ((static_cast<uint64_t>(endpoint) << 32) | clusterId) * 0x9E3779B97F4A7C15ull;
+    return 1ull << (hash >> 58);
+}
+
+uint64_t LatencyTracer::Histogram::Percentile(double fraction) const
+{
+    VerifyOrReturnValue(mCount > 0, 0);
+
+    uint64_t rank       = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(mCount))));
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < kBucketCount; bucket++)
+    {
+        cumulative += mBuckets[bucket];
+        if (cumulative >= rank)
+        {
+            return std::min(UpperBoundOf(bucket), mMax);
+        }
+    }
+    return mMax;
+}
+
+LatencyTracer::TraceId LatencyTracer::Begin(EndpointId endpoint, ClusterId clusterId, bool isCommand)
+{
+    VerifyOrReturnValue(mEnabled, kInvalidTrace);
+
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ExpireStale(now);
+
+    Trace * slot = nullptr;
+    for (auto & trace : mOpen)
+    {
+        if (trace.id == kInvalidTrace)
+        {
+            slot = &trace;
+            break;
+        }
+        if (slot == nullptr || trace.stamps[0] < slot->stamps[0])
+        {
+            slot = &trace;
+        }
+    }
+    if (slot->id != kInvalidTrace)
+    {
+        // Table full, close the oldest trace with what it has
+        Complete(*slot);
+    }
+
+    slot->id        = mNextId++;
+    slot->endpoint  = endpoint;
+    slot->clusterId = clusterId;
+    slot->isCommand = isCommand;
+    slot->stamped   = StageBit(Stage::kReceived);
+    slot->stamps[static_cast<size_t>(Stage::kReceived)] = now;
+    if (mNextId == kInvalidTrace)
+    {
+        mNextId++;
+    }
+    mOpenCount++;
+    UpdateFilterLocked();
+    return slot->id;
+}
+
+void LatencyTracer::Mark(TraceId trace, Stage stage)
+{
+    VerifyOrReturn(trace != kInvalidTrace && mEnabled.load(std::memory_order_relaxed));
+
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Trace * open = FindOpen(trace);
+    VerifyOrReturn(open != nullptr);
+    open->stamps[static_cast<size_t>(stage)] = now;
+    open->stamped |= StageBit(stage);
+}
+
+void LatencyTracer::OnReportScheduled(EndpointId endpoint, ClusterId clusterId)
+{
+    // Reports are pushed on every value update from any thread, keep everything but traced clusters lock-free
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed) &&
+                   (mOpenFilter.load(std::memory_order_acquire) & FilterBit(endpoint, clusterId)) != 0);
+
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mLock);
+
+    for (auto & trace : mOpen)
+    {
+        if (trace.id != kInvalidTrace && trace.endpoint == endpoint && trace.clusterId == clusterId &&
+            !(trace.stamped & StageBit(Stage::kReportScheduled)))
+        {
+            trace.stamps[static_cast<size_t>(Stage::kReportScheduled)] = now;
+            trace.stamped |= StageBit(Stage::kReportScheduled);
+        }
+    }
+}
+
+void LatencyTracer::OnReportFlushed(EndpointId endpoint, ClusterId clusterId)
+{
+    VerifyOrReturn(mEnabled.load(std::memory_order_relaxed) &&
+                   (mOpenFilter.load(std::memory_order_acquire) & FilterBit(endpoint, clusterId)) != 0);
+
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mLock);
+
+    for (auto & trace : mOpen)
+    {
+        if (trace.id != kInvalidTrace && trace.endpoint == endpoint && trace.clusterId == clusterId &&
+            (trace.stamped & StageBit(Stage::kReportScheduled)))
+        {
+            trace.stamps[static_cast<size_t>(Stage::kReportFlushed)] = now;
+            trace.stamped |= StageBit(Stage::kReportFlushed);
+            Complete(trace);
+        }
+    }
+}
+
+LatencyTracer::Trace * LatencyTracer::FindOpen(TraceId trace)
+{
+    for (auto & open : mOpen)
+    {
+        if (open.id == trace)
+        {
+            return &open;
+        }
+    }
+    return nullptr;
+}
+
+void LatencyTracer::Complete(Trace & trace)
+{
+    static constexpr Stage kSegmentStages[][2] = {
+        { Stage::kReceived, Stage::kJniEnter },        { Stage::kJniEnter, Stage::kJniExit },
+        { Stage::kReceived, Stage::kReportScheduled }, { Stage::kReportScheduled, Stage::kReportFlushed },
+        { Stage::kReceived, Stage::kReportFlushed },
+    };
+    static_assert(sizeof(kSegmentStages) / sizeof(kSegmentStages[0]) == static_cast<size_t>(Segment::kCount),
+                  "one stage pair per segment");
+
+    ClusterHistograms & histograms = mHistograms[trace.clusterId];
+    for (size_t segment = 0; segment < static_cast<size_t>(Segment::kCount); segment++)
+    {
+        Stage from = kSegmentStages[segment][0];
+        Stage to   = kSegmentStages[segment][1];
+        if ((trace.stamped & StageBit(from)) && (trace.stamped & StageBit(to)))
+        {
+            auto elapsed = trace.stamps[static_cast<size_t>(to)] - trace.stamps[static_cast<size_t>(from)];
+            auto us      = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            histograms[segment].Record(static_cast<uint64_t>(std::max<int64_t>(us, 0)));
+        }
+    }
+
+    ChipLogDetail(Zcl, "LatencyTracer: %s trace %" PRIu32 " ep=%u cluster=0x%" PRIx32 " closed, stages=0x%02x",
+                  trace.isCommand ? "command" : "write", trace.id, trace.endpoint, trace.clusterId, trace.stamped);
+    trace.id = kInvalidTrace;
+    mOpenCount--;
+    UpdateFilterLocked();
+}
+
+void LatencyTracer::UpdateFilterLocked()
+{
+    uint64_t filter = 0;
+    for (const auto & trace : mOpen)
+    {
+        if (trace.id != kInvalidTrace)
+        {
+            filter |= FilterBit(trace.endpoint, trace.clusterId);
+        }
+    }
+    mOpenFilter.store(filter, std::memory_order_release);
+}
+
+void LatencyTracer::ExpireStale(Clock::time_point now)
+{
+    for (auto & trace : mOpen)
+    {
+        if (trace.id != kInvalidTrace && now - trace.stamps[static_cast<size_t>(Stage::kReceived)] > kTraceTimeout)
+        {
+            Complete(trace);
+        }
+    }
+}
+
+void LatencyTracer::Reset()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    for (auto & trace : mOpen)
+    {
+        trace.id = kInvalidTrace;
+    }
+    mOpenCount = 0;
+    mOpenFilter.store(0, std::memory_order_release);
+    mHistograms.clear();
+}
+
+bool LatencyTracer::GetSummary(ClusterId clusterId, std::array<Summary, static_cast<size_t>(Segment::kCount)> & summary)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ExpireStale(Clock::now());
+    auto it = mHistograms.find(clusterId);
+    VerifyOrReturnValue(it != mHistograms.end(), false);
+
+    for (size_t segment = 0; segment < summary.size(); segment++)
+    {
+        const Histogram & histogram = it->second[segment];
+        summary[segment]            = { histogram.GetCount(), histogram.Percentile(0.5), histogram.Percentile(0.99),
+                             histogram.GetMax() };
+    }
+    return true;
+}
+
+std::string LatencyTracer::Dump()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ExpireStale(Clock::now());
+    std::string dump;
+    for (const auto & cluster : mHistograms)
+    {
+        for (size_t segment = 0; segment < static_cast<size_t>(Segment::kCount); segment++)
+        {
+            const Histogram & histogram = cluster.second[segment];
+            if (histogram.GetCount() == 0)
+            {
+                continue;
+            }
+
+            char line[128];
+            snprintf(line, sizeof(line), "cluster=0x%04" PRIx32 " %-12s n=%" PRIu64 " p50=%" PRIu64 "us p99=%" PRIu64
+                     "us max=%" PRIu64 "us",
+                     cluster.first, SegmentName(segment), histogram.GetCount(), histogram.Percentile(0.5),
+                     histogram.Percentile(0.99), histogram.GetMax());
+            ChipLogProgress(Zcl, "LatencyTracer: %s", line);
+            dump.append(line).append("\n");
+        }
+    }
+    return dump;
+}
@@ -0,0 +1,156 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Traces commands and attribute writes from the interaction model to the report that confirms them.
+ *
+ * Each command or write gets a trace ID and monotonic timestamps at every stage it passes: receipt from the
+ * interaction model, entry into and return from the Java upcall, the confirming report being queued (ReportQueue::Push
+ * for the same endpoint and cluster, from any thread) and that report being flushed to the reporting engine.
+ * Completed traces feed per-cluster latency histograms of the intervals between the stages.
+ *
+ * Tracing is off by default. While it is off, or while no open trace matches the endpoint and cluster, the hooks
+ * return without taking the lock, so report pushes stay lock-free.
+ */
+class LatencyTracer
+{
+public:
+    using TraceId = uint32_t;
+
+    static constexpr TraceId kInvalidTrace = 0;
+
+    enum class Stage : uint8_t
+    {
+        kReceived,
+        kJniEnter,
+        kJniExit,
+        kReportScheduled,
+        kReportFlushed,
+        kCount,
+    };
+
+    // Intervals kept as histograms
+    enum class Segment : uint8_t
+    {
+        kDispatch,    // received -> JNI enter
+        kUpcall,      // JNI enter -> JNI exit
+        kUntilReport, // received -> report scheduled
+        kReportQueue, // report scheduled -> report flushed
+        kTotal,       // received -> report flushed
+        kCount,
+    };
+
+    struct Summary
+    {
+        uint64_t count;
+        uint64_t p50Us;
+        uint64_t p99Us;
+        uint64_t maxUs;
+    };
+
+    static LatencyTracer & GetInstance() { return sInstance; }
+
+    // Starts a trace at IM receipt, kInvalidTrace if tracing is disabled
+    TraceId Begin(chip::EndpointId endpoint, chip::ClusterId clusterId, bool isCommand);
+    void Mark(TraceId trace, Stage stage);
+
+    // Report hooks, matched to open traces by endpoint and cluster
+    void OnReportScheduled(chip::EndpointId endpoint, chip::ClusterId clusterId);
+    void OnReportFlushed(chip::EndpointId endpoint, chip::ClusterId clusterId);
+
+    void SetEnabled(bool enabled) { mEnabled = enabled; }
+    void Reset();
+
+    // false if nothing was recorded for the cluster
+    bool GetSummary(chip::ClusterId clusterId, std::array<Summary, static_cast<size_t>(Segment::kCount)> & summary);
+    // one line per cluster and segment, also written to the log
+    std::string Dump();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Log-linear buckets: exact below 16 us, then 8 buckets per power of two (at most 12.5 % error)
+    class Histogram
+    {
+    public:
+        static constexpr size_t kLinearBuckets = 16;
+        static constexpr size_t kSubBuckets    = 8;
+        static constexpr size_t kBucketCount   = kLinearBuckets + (64 - 4) * kSubBuckets;
+
+        void Record(uint64_t us);
+        uint64_t Percentile(double fraction) const;
+        uint64_t GetCount() const { return mCount; }
+        uint64_t GetMax() const { return mMax; }
+
+    private:
+        static size_t BucketOf(uint64_t us);
+        static uint64_t UpperBoundOf(size_t bucket);
+
+        std::array<uint32_t, kBucketCount> mBuckets{};
+        uint64_t mCount = 0;
+        uint64_t mMax   = 0;
+    };
+
+    using ClusterHistograms = std::array<Histogram, static_cast<size_t>(Segment::kCount)>;
+
+    struct Trace
+    {
+        TraceId id = kInvalidTrace;
+        chip::EndpointId endpoint;
+        chip::ClusterId clusterId;
+        bool isCommand;
+        uint8_t stamped; // bit per Stage
+        std::array<Clock::time_point, static_cast<size_t>(Stage::kCount)> stamps;
+    };
+
+    static constexpr size_t kMaxOpenTraces = 32;
+    // a trace whose report does not show up within this time is closed with the stages it reached
+    static constexpr std::chrono::seconds kTraceTimeout{ 2 };
+
+    static LatencyTracer sInstance;
+
+    // bit of an endpoint and cluster in mOpenFilter
+    static uint64_t FilterBit(chip::EndpointId endpoint, chip::ClusterId clusterId);
+
+    Trace * FindOpen(TraceId trace);
+    void Complete(Trace & trace);
+    void ExpireStale(Clock::time_point now);
+    // recomputes mOpenFilter from the open traces, with mLock held
+    void UpdateFilterLocked();
+
+    std::mutex mLock;
+    std::array<Trace, kMaxOpenTraces> mOpen;
+    std::atomic<size_t> mOpenCount{ 0 };
+    // FilterBit of every open trace, checked by the report hooks before they lock
+    std::atomic<uint64_t> mOpenFilter{ 0 };
+    TraceId mNextId = 1;
+    std::map<chip::ClusterId, ClusterHistograms> mHistograms;
+    std::atomic<bool> mEnabled{ false };
+};
@@ -0,0 +1,51 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "MetadataArena.h"
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+std::atomic<uint64_t> MetadataArena::sLiveBytes{ 0 };
+std::atomic<uint64_t> MetadataArena::sPeakBytes{ 0 };
+std::atomic<uint64_t> MetadataArena::sLiveArenas{ 0 };
+
+bool MetadataArena::Init()
+{
+    VerifyOrReturnValue(mBlock == nullptr, false);
+
+    // malloc alignment covers every type placed in the arena
+    mBlock = static_cast<uint8_t *>(chip::Platform::MemoryAlloc(mCapacity > 0 ? mCapacity : 1));
+    VerifyOrReturnValue(mBlock != nullptr, false);
+
+    uint64_t live = (sLiveBytes += mCapacity);
+    uint64_t peak = sPeakBytes.load();
+    while (live > peak && !sPeakBytes.compare_exchange_weak(peak, live))
+    {
+    }
+    sLiveArenas++;
+    return true;
+}
+
+MetadataArena::~MetadataArena()
+{
+    VerifyOrReturn(mBlock != nullptr);
+    chip::Platform::MemoryFree(mBlock);
+    sLiveBytes -= mCapacity;
+    sLiveArenas--;
+}
@@ -0,0 +1,85 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Single contiguous block for the metadata of a dynamic endpoint.
+ *
+ * The size is computed up front with Reserve<T>() for every array, then the block is allocated once and carved
+ * with Allocate<T>() in the same order. Everything is released together with the arena, so removing an endpoint
+ * returns all of its metadata, and the arrays the SDK walks (clusters, attributes) sit next to each other.
+ *
+ * Live and peak bytes over all arenas are tracked process-wide.
+ */
+class MetadataArena
+{
+public:
+    MetadataArena() = default;
+    ~MetadataArena();
+
+    MetadataArena(const MetadataArena &)             = delete;
+    MetadataArena & operator=(const MetadataArena &) = delete;
+
+    // sizing pass
+    template <typename T>
+    void Reserve(size_t count)
+    {
+        mCapacity = AlignUp(mCapacity, alignof(T)) + sizeof(T) * count;
+    }
+
+    // allocates the reserved capacity; false if out of memory
+    bool Init();
+
+    // carving pass: uninitialized storage for count objects, to be constructed by the caller (e.g. with
+    // std::uninitialized_copy); nullptr if the request exceeds what was reserved
+    template <typename T>
+    T * Allocate(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is released without running destructors");
+        size_t offset = AlignUp(mUsed, alignof(T));
+        if (mBlock == nullptr || offset + sizeof(T) * count > mCapacity)
+        {
+            return nullptr;
+        }
+        mUsed = offset + sizeof(T) * count;
+        return reinterpret_cast<T *>(mBlock + offset);
+    }
+
+    size_t GetSize() const { return mCapacity; }
+
+    static uint64_t GetLiveBytes() { return sLiveBytes; }
+    static uint64_t GetPeakBytes() { return sPeakBytes; }
+    static uint64_t GetLiveArenas() { return sLiveArenas; }
+
+private:
+    static size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+    uint8_t * mBlock = nullptr;
+    size_t mCapacity = 0;
+    size_t mUsed     = 0;
+
+    static std::atomic<uint64_t> sLiveBytes;
+    static std::atomic<uint64_t> sPeakBytes;
+    static std::atomic<uint64_t> sLiveArenas;
+};
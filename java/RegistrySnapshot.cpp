@@ -0,0 +1,558 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "RegistrySnapshot.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace chip;
+
+RegistrySnapshot RegistrySnapshot::sInstance;
+
+namespace {
+
+constexpr uint32_t kMagic   = 0x5342524d; // "MRBS"
+constexpr uint16_t kVersion = 2;
+// magic, version, reserved, payload size, payload checksum
+constexpr size_t kHeaderSize = 4 + 2 + 2 + 4 + 8;
+
+// changes closer together than this (e.g. a bulk add) are written as one snapshot
+constexpr auto kSettleDelay = std::chrono::milliseconds(500);
+// attribute changes alone are written at most this often
+constexpr auto kValueFlushDelay = std::chrono::seconds(5);
+
+// next to the snapshot file, see Save(true)
+constexpr char kCleanMarkerSuffix[] = ".clean";
+
+uint64_t Checksum(const uint8_t * data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+class Writer
+{
+public:
+    explicit Writer(std::vector<uint8_t> & out) : mOut(out) {}
+
+    template <typename T>
+    void Put(T value)
+    {
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            mOut.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+        }
+    }
+
+    void PutBytes(const uint8_t * data, size_t size)
+    {
+        Put(static_cast<uint16_t>(size));
+        mOut.insert(mOut.end(), data, data + size);
+    }
+
+    void PutString(const std::string & value) { PutBytes(reinterpret_cast<const uint8_t *>(value.data()), value.size()); }
+
+private:
+    std::vector<uint8_t> & mOut;
+};
+
+// Bounds-checked cursor; once a read runs past the end every further read fails
+class Reader
+{
+public:
+    Reader(const uint8_t * data, size_t size) : mData(data), mSize(size) {}
+
+    template <typename T>
+    bool Get(T & value)
+    {
+        VerifyOrReturnValue(mOffset + sizeof(T) <= mSize, false);
+        uint64_t raw = 0;
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            raw |= static_cast<uint64_t>(mData[mOffset + i]) << (8 * i);
+        }
+        mOffset += sizeof(T);
+        value = static_cast<T>(raw);
+        return true;
+    }
+
+    bool GetBytes(std::vector<uint8_t> & value)
+    {
+        uint16_t size;
+        VerifyOrReturnValue(Get(size) && mOffset + size <= mSize, false);
+        value.assign(mData + mOffset, mData + mOffset + size);
+        mOffset += size;
+        return true;
+    }
+
+    bool GetString(std::string & value)
+    {
+        uint16_t size;
+        VerifyOrReturnValue(Get(size) && mOffset + size <= mSize, false);
+        value.assign(reinterpret_cast<const char *>(mData + mOffset), size);
+        mOffset += size;
+        return true;
+    }
+
+    bool AtEnd() const { return mOffset == mSize; }
+
+private:
+    const uint8_t * mData;
+    size_t mSize;
+    size_t mOffset = 0;
+};
+
+void EncodeTemplate(Writer & writer, const RegistrySnapshot::TemplateRecord & record)
+{
+    const EndpointDefinition & definition = record.definition;
+
+    writer.Put(record.id);
+    writer.Put(static_cast<uint8_t>(record.registered));
+
+    writer.Put(static_cast<uint16_t>(definition.clusters.size()));
+    for (size_t i = 0; i < definition.clusters.size(); i++)
+    {
+        writer.Put(definition.clusters[i].clusterId);
+        writer.Put(definition.clusters[i].mask);
+        writer.Put(static_cast<uint16_t>(definition.attributes[i].size()));
+        for (const auto & attribute : definition.attributes[i])
+        {
+            writer.Put(attribute.attributeId);
+            writer.Put(attribute.size);
+            writer.Put(attribute.attributeType);
+            writer.Put(attribute.mask);
+        }
+    }
+
+    writer.Put(static_cast<uint16_t>(definition.deviceTypes.size()));
+    for (const auto & deviceType : definition.deviceTypes)
+    {
+        writer.Put(deviceType.deviceTypeId);
+        writer.Put(deviceType.deviceVersion);
+    }
+
+    writer.Put(static_cast<uint16_t>(definition.storeAttributes.size()));
+    for (const auto & desc : definition.storeAttributes)
+    {
+        writer.Put(desc.clusterId);
+        writer.Put(desc.attributeId);
+        writer.Put(desc.type);
+        writer.Put(desc.size);
+        writer.Put(desc.flags);
+        writer.PutBytes(desc.defaultValue.data(), desc.defaultValue.size());
+    }
+}
+
+bool DecodeTemplate(Reader & reader, RegistrySnapshot::TemplateRecord & record)
+{
+    EndpointDefinition & definition = record.definition;
+    uint8_t registered;
+    uint16_t clusterCount;
+    VerifyOrReturnValue(reader.Get(record.id) && reader.Get(registered) && reader.Get(clusterCount), false);
+    record.registered = (registered != 0);
+
+    for (uint16_t i = 0; i < clusterCount; i++)
+    {
+        EmberAfCluster cluster = {};
+        uint16_t attributeCount;
+        VerifyOrReturnValue(reader.Get(cluster.clusterId) && reader.Get(cluster.mask) && reader.Get(attributeCount), false);
+
+        std::vector<EmberAfAttributeMetadata> attributes;
+        for (uint16_t j = 0; j < attributeCount; j++)
+        {
+            EmberAfAttributeMetadata attribute = { ZAP_EMPTY_DEFAULT(), 0, 0, 0, 0 };
+            VerifyOrReturnValue(reader.Get(attribute.attributeId) && reader.Get(attribute.size) &&
+                                    reader.Get(attribute.attributeType) && reader.Get(attribute.mask),
+                                false);
+            attributes.push_back(attribute);
+        }
+        definition.clusters.push_back(cluster);
+        definition.attributes.push_back(std::move(attributes));
+    }
+
+    uint16_t deviceTypeCount;
+    VerifyOrReturnValue(reader.Get(deviceTypeCount), false);
+    for (uint16_t i = 0; i < deviceTypeCount; i++)
+    {
+        EmberAfDeviceType deviceType;
+        VerifyOrReturnValue(reader.Get(deviceType.deviceTypeId) && reader.Get(deviceType.deviceVersion), false);
+        definition.deviceTypes.push_back(deviceType);
+    }
+
+    uint16_t storeCount;
+    VerifyOrReturnValue(reader.Get(storeCount), false);
+    for (uint16_t i = 0; i < storeCount; i++)
+    {
+        AttributeStore::AttributeDesc desc;
+        VerifyOrReturnValue(reader.Get(desc.clusterId) && reader.Get(desc.attributeId) && reader.Get(desc.type) &&
+                                reader.Get(desc.size) && reader.Get(desc.flags) && reader.GetBytes(desc.defaultValue),
+                            false);
+        definition.storeAttributes.push_back(std::move(desc));
+    }
+    return true;
+}
+
+} // namespace
+
+void RegistrySnapshot::Encode(const Contents & contents, std::vector<uint8_t> & image)
+{
+    image.assign(kHeaderSize, 0);
+    Writer writer(image);
+
+    writer.Put(static_cast<uint32_t>(contents.templates.size()));
+    for (const auto & record : contents.templates)
+    {
+        EncodeTemplate(writer, record);
+    }
+
+    writer.Put(static_cast<uint32_t>(contents.devices.size()));
+    for (const auto & device : contents.devices)
+    {
+        writer.Put(device.endpoint);
+        writer.Put(device.parentEndpoint);
+        writer.Put(device.templateId);
+        writer.PutString(device.name);
+        writer.PutString(device.uniqueId);
+        writer.Put(static_cast<uint16_t>(device.values.size()));
+        for (const auto & value : device.values)
+        {
+            writer.Put(value.clusterId);
+            writer.Put(value.attributeId);
+            writer.PutBytes(value.bytes.data(), value.bytes.size());
+        }
+    }
+
+    writer.Put(static_cast<uint32_t>(contents.dataVersions.size()));
+    for (const auto & entry : contents.dataVersions)
+    {
+        writer.Put(entry.endpoint);
+        writer.Put(static_cast<uint16_t>(entry.clusters.size()));
+        for (const auto & cluster : entry.clusters)
+        {
+            writer.Put(cluster.clusterId);
+            writer.Put(cluster.version);
+            writer.Put(cluster.fingerprint);
+            writer.Put(static_cast<uint8_t>(cluster.comparable));
+        }
+    }
+
+    std::vector<uint8_t> header;
+    Writer headerWriter(header);
+    headerWriter.Put(kMagic);
+    headerWriter.Put(kVersion);
+    headerWriter.Put(static_cast<uint16_t>(0));
+    headerWriter.Put(static_cast<uint32_t>(image.size() - kHeaderSize));
+    headerWriter.Put(Checksum(image.data() + kHeaderSize, image.size() - kHeaderSize));
+    std::copy(header.begin(), header.end(), image.begin());
+}
+
+bool RegistrySnapshot::Decode(ByteSpan image, Contents * contents)
+{
+    Reader header(image.data(), image.size());
+    uint32_t magic, payloadSize;
+    uint16_t version, reserved;
+    uint64_t checksum;
+    VerifyOrReturnValue(header.Get(magic) && header.Get(version) && header.Get(reserved) && header.Get(payloadSize) &&
+                            header.Get(checksum),
+                        false);
+    VerifyOrReturnValue(magic == kMagic && version == kVersion, false,
+                        ChipLogError(Zcl, "RegistrySnapshot: unsupported snapshot (version %u)", version));
+    VerifyOrReturnValue(payloadSize == image.size() - kHeaderSize &&
+                            checksum == Checksum(image.data() + kHeaderSize, payloadSize),
+                        false, ChipLogError(Zcl, "RegistrySnapshot: snapshot is corrupted"));
+    VerifyOrReturnValue(contents != nullptr, true);
+
+    Reader reader(image.data() + kHeaderSize, payloadSize);
+    uint32_t templateCount;
+    VerifyOrReturnValue(reader.Get(templateCount), false);
+    for (uint32_t i = 0; i < templateCount; i++)
+    {
+        TemplateRecord record;
+        VerifyOrReturnValue(DecodeTemplate(reader, record), false);
+        contents->templates.push_back(std::move(record));
+    }
+
+    uint32_t deviceCount;
+    VerifyOrReturnValue(reader.Get(deviceCount), false);
+    for (uint32_t i = 0; i < deviceCount; i++)
+    {
+        DeviceRecord device;
+        uint16_t valueCount;
+        VerifyOrReturnValue(reader.Get(device.endpoint) && reader.Get(device.parentEndpoint) && reader.Get(device.templateId) &&
+                                reader.GetString(device.name) && reader.GetString(device.uniqueId) && reader.Get(valueCount),
+                            false);
+        for (uint16_t j = 0; j < valueCount; j++)
+        {
+            Value value;
+            VerifyOrReturnValue(reader.Get(value.clusterId) && reader.Get(value.attributeId) && reader.GetBytes(value.bytes),
+                                false);
+            device.values.push_back(std::move(value));
+        }
+        contents->devices.push_back(std::move(device));
+    }
+
+    uint32_t entryCount;
+    VerifyOrReturnValue(reader.Get(entryCount), false);
+    for (uint32_t i = 0; i < entryCount; i++)
+    {
+        DataVersionStore::Entry entry;
+        uint16_t clusterCount;
+        VerifyOrReturnValue(reader.Get(entry.endpoint) && reader.Get(clusterCount), false);
+        for (uint16_t j = 0; j < clusterCount; j++)
+        {
+            DataVersionStore::ClusterVersion cluster;
+            uint8_t comparable;
+            VerifyOrReturnValue(reader.Get(cluster.clusterId) && reader.Get(cluster.version) && reader.Get(cluster.fingerprint) &&
+                                    reader.Get(comparable),
+                                false);
+            cluster.comparable = (comparable != 0);
+            entry.clusters.push_back(cluster);
+        }
+        contents->dataVersions.push_back(std::move(entry));
+    }
+    return reader.AtEnd();
+}
+
+bool RegistrySnapshot::Configure(const std::string & path, Collector collector)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mPath      = path;
+        mCollector = collector;
+    }
+    return ReadFile(nullptr);
+}
+
+bool RegistrySnapshot::IsConfigured()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return !mPath.empty() && mCollector != nullptr;
+}
+
+bool RegistrySnapshot::Load(Contents & contents)
+{
+    contents = Contents();
+    if (!ReadFile(&contents))
+    {
+        contents = Contents();
+        return false;
+    }
+    return true;
+}
+
+bool RegistrySnapshot::ReadFile(Contents * contents)
+{
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        path = mPath;
+    }
+    VerifyOrReturnValue(!path.empty(), false);
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    VerifyOrReturnValue(fd >= 0, false);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(kHeaderSize))
+    {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void * map  = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    VerifyOrReturnValue(map != MAP_FAILED, false, ChipLogError(Zcl, "RegistrySnapshot: mmap failed: %d", errno));
+
+    bool decoded = Decode(ByteSpan(static_cast<const uint8_t *>(map), size), contents);
+    munmap(map, size);
+    return decoded;
+}
+
+bool RegistrySnapshot::WriteFile(const std::vector<uint8_t> & image)
+{
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        path = mPath;
+    }
+    VerifyOrReturnValue(!path.empty(), false);
+
+    // a crash while writing leaves the previous snapshot in place
+    std::string temporary = path + ".tmp";
+    int fd                = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    VerifyOrReturnValue(fd >= 0, false, ChipLogError(Zcl, "RegistrySnapshot: cannot create %s: %d", temporary.c_str(), errno));
+
+    size_t written = 0;
+    while (written < image.size())
+    {
+        ssize_t result = write(fd, image.data() + written, image.size() - written);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            break;
+        }
+        written += static_cast<size_t>(result);
+    }
+    bool ok = (written == image.size()) && fsync(fd) == 0;
+    close(fd);
+
+    ok = ok && rename(temporary.c_str(), path.c_str()) == 0;
+    if (!ok)
+    {
+        ChipLogError(Zcl, "RegistrySnapshot: failed to write %s: %d", path.c_str(), errno);
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    mWrites++;
+    mLastWriteBytes = image.size();
+    return true;
+}
+
+bool RegistrySnapshot::Save(bool cleanShutdown)
+{
+    Collector collector;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        collector      = mCollector;
+        mDirty         = false;
+        mValuesChanged = false;
+    }
+    VerifyOrReturnValue(collector != nullptr, false);
+
+    std::lock_guard<std::mutex> writeLock(mWriteLock);
+
+    auto start = std::chrono::steady_clock::now();
+    Contents contents;
+    collector(contents);
+    std::vector<uint8_t> image;
+    Encode(contents, image);
+    VerifyOrReturnValue(WriteFile(image), false);
+
+    if (cleanShutdown)
+    {
+        // only if nothing changed since the registry was collected
+        std::lock_guard<std::mutex> lock(mLock);
+        if (!mDirty && !mValuesChanged && !mCleanMarker)
+        {
+            int fd = open((mPath + kCleanMarkerSuffix).c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+            mCleanMarker = (fd >= 0) && fsync(fd) == 0;
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+    ChipLogProgress(Zcl, "RegistrySnapshot: saved %u devices (%u bytes) in %" PRIu64 " us",
+                    static_cast<unsigned>(contents.devices.size()), static_cast<unsigned>(image.size()),
+                    static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+    return true;
+}
+
+bool RegistrySnapshot::ConsumeCleanShutdownMarker()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnValue(!mPath.empty(), false);
+
+    std::string marker = mPath + kCleanMarkerSuffix;
+    bool clean         = access(marker.c_str(), F_OK) == 0;
+    unlink(marker.c_str());
+    mCleanMarker = false;
+    return clean;
+}
+
+void RegistrySnapshot::ClearCleanMarkerLocked()
+{
+    VerifyOrReturn(mCleanMarker);
+    unlink((mPath + kCleanMarkerSuffix).c_str());
+    mCleanMarker = false;
+}
+
+void RegistrySnapshot::MarkDirty()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturn(!mPath.empty() && mCollector != nullptr);
+
+    ClearCleanMarkerLocked();
+    mDirty = true;
+    NotifyWriterLocked();
+}
+
+void RegistrySnapshot::MarkValuesChanged()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturn(!mValuesChanged && !mPath.empty() && mCollector != nullptr);
+
+    ClearCleanMarkerLocked();
+    mValuesChanged = true;
+    NotifyWriterLocked();
+}
+
+void RegistrySnapshot::NotifyWriterLocked()
+{
+    if (!mWriterStarted)
+    {
+        mWriterStarted = true;
+        std::thread(&RegistrySnapshot::Run, this).detach();
+    }
+    mWakeup.notify_one();
+}
+
+void RegistrySnapshot::Run()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true)
+    {
+        mWakeup.wait(lock, [this] { return mDirty || mValuesChanged; });
+
+        if (!mDirty)
+        {
+            mWakeup.wait_for(lock, kValueFlushDelay, [this] { return mDirty; });
+        }
+        // topology changes: wait until no change arrived for kSettleDelay
+        while (mDirty)
+        {
+            mDirty = false;
+            mWakeup.wait_for(lock, kSettleDelay, [this] { return mDirty; });
+        }
+
+        lock.unlock();
+        Save();
+        lock.lock();
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "DataVersionStore.h"
+#include "EndpointTemplates.h"
+
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Binary snapshot of the bridged device registry, so that a restarted bridge re-creates its endpoints natively
+ * instead of Kotlin rebuilding every device.
+ *
+ * The snapshot holds the endpoint templates in use and, per device, its endpoint ID, parent, name, unique ID, template
+ * and last native attribute values, along with the cluster DataVersions of online and offline devices. After a
+ * topology change it is rewritten by a background thread, once changes have settled, and after value changes at most
+ * every few seconds: the registry is collected (only its topology under the stack lock), then written to a temporary
+ * file that replaces the previous snapshot. At startup the file is mapped read-only and decoded in place.
+ *
+ * All integers are little-endian; a checksum over the payload rejects torn or foreign files.
+ *
+ * DataVersions may move on for up to a flush delay after the last write, so they are only trusted after a clean
+ * shutdown: Save(true) leaves a marker file next to the snapshot, which the next topology or value change removes.
+ */
+class RegistrySnapshot
+{
+public:
+    struct Value
+    {
+        chip::ClusterId clusterId;
+        chip::AttributeId attributeId;
+        std::vector<uint8_t> bytes; // ember buffer encoding, as for AttributeStore::SetRawValue
+    };
+
+    struct DeviceRecord
+    {
+        chip::EndpointId endpoint;
+        chip::EndpointId parentEndpoint;
+        uint32_t templateId; // TemplateRecord::id
+        std::string name;
+        std::string uniqueId;
+        std::vector<Value> values;
+    };
+
+    struct TemplateRecord
+    {
+        uint32_t id;     // template ID when the snapshot was written
+        bool registered; // registered by ID, see EndpointTemplateRegistry::Register
+        // acceptedCommandList of the clusters is not persisted and left null when decoding
+        EndpointDefinition definition;
+    };
+
+    struct Contents
+    {
+        std::vector<TemplateRecord> templates;
+        std::vector<DeviceRecord> devices;
+        std::vector<DataVersionStore::Entry> dataVersions; // by endpoint, online devices first
+    };
+
+    // Fills the registry contents; called without the stack lock, which it takes only to read the registry topology
+    using Collector = void (*)(Contents & contents);
+
+    static RegistrySnapshot & GetInstance() { return sInstance; }
+
+    // Sets the snapshot file and how to collect it. Returns true if the file holds a valid snapshot.
+    bool Configure(const std::string & path, Collector collector);
+    bool IsConfigured();
+
+    // Maps and decodes the snapshot file; false if it is missing or invalid
+    bool Load(Contents & contents);
+
+    // Records a topology change, the snapshot is rewritten once changes settle
+    void MarkDirty();
+    // Records attribute changes (and so DataVersion changes), written with a longer delay than topology changes
+    void MarkValuesChanged();
+    // Collects and writes the snapshot now; must not be called on the Matter thread. With cleanShutdown, also marks
+    // the snapshot as current until the next change (e.g. when the app is stopped).
+    bool Save(bool cleanShutdown = false);
+    // Whether the snapshot was written by a clean shutdown with no change after it. Removes the marker, so it is only
+    // reported once per process start: a crash from here on leaves the snapshot unclean.
+    bool ConsumeCleanShutdownMarker();
+
+    uint64_t GetWriteCount() const { return mWrites; }
+    uint64_t GetLastWriteBytes() const { return mLastWriteBytes; }
+
+private:
+    static RegistrySnapshot sInstance;
+
+    static void Encode(const Contents & contents, std::vector<uint8_t> & image);
+    static bool Decode(chip::ByteSpan image, Contents * contents);
+
+    // maps the file and decodes it, or only validates it if contents is null
+    bool ReadFile(Contents * contents);
+    bool WriteFile(const std::vector<uint8_t> & image);
+    // starts the writer thread on first use; called with mLock held
+    void NotifyWriterLocked();
+    // removes the clean-shutdown marker on the first change after it was written; called with mLock held
+    void ClearCleanMarkerLocked();
+    void Run();
+
+    std::mutex mLock;
+    std::condition_variable mWakeup;
+    std::string mPath;
+    Collector mCollector = nullptr;
+    bool mDirty          = false;
+    bool mValuesChanged  = false;
+    bool mWriterStarted  = false;
+    bool mCleanMarker    = false; // the marker file exists
+    std::mutex mWriteLock; // serializes Save() calls of the writer thread and Java
+
+    std::atomic<uint64_t> mWrites{ 0 };
+    std::atomic<uint64_t> mLastWriteBytes{ 0 };
+};
@@ -0,0 +1,145 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ReportQueue.h"
+#include "LatencyTracer.h"
+#include "RegistrySnapshot.h"
+
+#include <app/reporting/reporting.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace chip;
+
+static_assert((ReportQueue::kCapacity & (ReportQueue::kCapacity - 1)) == 0, "ReportQueue capacity must be a power of two");
+
+ReportQueue ReportQueue::sInstance;
+
+ReportQueue::ReportQueue()
+{
+    for (size_t i = 0; i < kCapacity; i++)
+    {
+        mCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ReportQueue::Push(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+    Cell * cell;
+    while (true)
+    {
+        cell            = &mCells[pos & (kCapacity - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff   = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Full: the Matter thread is behind by a whole ring
+            mDropped++;
+            return false;
+        }
+        else
+        {
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->path = app::ConcreteAttributePath(endpoint, clusterId, attributeId);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    mEnqueued++;
+    LatencyTracer::GetInstance().OnReportScheduled(endpoint, clusterId);
+
+    ScheduleDrain();
+    return true;
+}
+
+void ReportQueue::ScheduleDrain()
+{
+    VerifyOrReturn(!mDrainScheduled.exchange(true));
+    if (DeviceLayer::PlatformMgr().ScheduleWork(Drain) != CHIP_NO_ERROR)
+    {
+        // The next push tries again
+        mDrainScheduled = false;
+        ChipLogError(Zcl, "ReportQueue: failed to schedule drain");
+    }
+}
+
+bool ReportQueue::Pop(app::ConcreteAttributePath & path)
+{
+    Cell * cell     = &mCells[mDequeuePos & (kCapacity - 1)];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    VerifyOrReturnValue(sequence == mDequeuePos + 1, false);
+
+    path = cell->path;
+    cell->sequence.store(mDequeuePos + kCapacity, std::memory_order_release);
+    mDequeuePos++;
+    return true;
+}
+
+void ReportQueue::Drain(intptr_t)
+{
+    ReportQueue & queue = sInstance;
+
+    // Reset before popping: a path pushed from now on is either drained below or schedules the next drain
+    queue.mDrainScheduled = false;
+
+    size_t count = 0;
+    while (count < kCapacity && queue.Pop(queue.mDrained[count]))
+    {
+        count++;
+    }
+    VerifyOrReturn(count > 0);
+    if (count == kCapacity)
+    {
+        // Producers kept up with the drain, pick up the rest on the next tick
+        queue.ScheduleDrain();
+    }
+
+    auto key = [](const app::ConcreteAttributePath & path) {
+        return std::make_tuple(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    };
+    std::sort(queue.mDrained, queue.mDrained + count,
+              [&key](const app::ConcreteAttributePath & a, const app::ConcreteAttributePath & b) { return key(a) < key(b); });
+    size_t unique = static_cast<size_t>(std::unique(queue.mDrained, queue.mDrained + count,
+                                                    [&key](const app::ConcreteAttributePath & a,
+                                                           const app::ConcreteAttributePath & b) { return key(a) == key(b); }) -
+                                        queue.mDrained);
+
+    queue.mCoalesced += count - unique;
+    for (size_t i = 0; i < unique; i++)
+    {
+        MatterReportingAttributeChangeCallback(queue.mDrained[i]);
+        LatencyTracer::GetInstance().OnReportFlushed(queue.mDrained[i].mEndpointId, queue.mDrained[i].mClusterId);
+    }
+    // the reports bumped DataVersions, which the registry snapshot persists
+    if (unique > 0)
+    {
+        RegistrySnapshot::GetInstance().MarkValuesChanged();
+    }
+}
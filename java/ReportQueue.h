@@ -0,0 +1,78 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/DataModelTypes.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Coalescing queue of attribute reports for the Matter thread.
+ *
+ * Any thread can push a changed attribute path into a fixed-capacity ring; the ring itself never allocates or locks.
+ * The first push after a drain also schedules a single task on the Matter event loop (PlatformMgr().ScheduleWork,
+ * which takes the event queue lock). That task drains the ring, drops duplicate paths and calls
+ * MatterReportingAttributeChangeCallback once per distinct path. When the ring is full the path is dropped and
+ * counted.
+ */
+class ReportQueue
+{
+public:
+    static constexpr size_t kCapacity = 1024; // power of two
+
+    static ReportQueue & GetInstance() { return sInstance; }
+
+    // false if the ring is full and the report was dropped
+    bool Push(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId);
+
+    uint64_t GetEnqueuedCount() const { return mEnqueued; }
+    uint64_t GetCoalescedCount() const { return mCoalesced; }
+    uint64_t GetDroppedCount() const { return mDropped; }
+
+private:
+    // Bounded queue after D. Vyukov: a cell is free for the producer claiming position p when its sequence is p,
+    // and holds a value for the consumer at position p when its sequence is p + 1.
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        chip::app::ConcreteAttributePath path;
+    };
+
+    static ReportQueue sInstance;
+    static void Drain(intptr_t);
+
+    ReportQueue();
+    bool Pop(chip::app::ConcreteAttributePath & path);
+    void ScheduleDrain();
+
+    Cell mCells[kCapacity];
+    std::atomic<size_t> mEnqueuePos{ 0 };
+    size_t mDequeuePos = 0; // Matter thread only
+    std::atomic<bool> mDrainScheduled{ false };
+
+    // Matter thread only, sized once so draining never allocates
+    chip::app::ConcreteAttributePath mDrained[kCapacity];
+
+    std::atomic<uint64_t> mEnqueued{ 0 };
+    std::atomic<uint64_t> mCoalesced{ 0 };
+    std::atomic<uint64_t> mDropped{ 0 };
+};
@@ -0,0 +1,199 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ReportThrottle.h"
+#include "ReportQueue.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace chip;
+
+ReportThrottle ReportThrottle::sInstance;
+
+void ReportThrottle::Configure(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, const Threshold & threshold)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    ConfigureLocked(Key(endpoint, clusterId, attributeId), threshold);
+}
+
+void ReportThrottle::ConfigureDefault(ClusterId clusterId, AttributeId attributeId, const Threshold & threshold)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    mDefaults[std::make_pair(clusterId, attributeId)] = threshold;
+    // Started here, at init, so rules created from defaults on the update path never start a thread
+    StartTimerThreadLocked();
+}
+
+void ReportThrottle::ConfigureLocked(const Key & key, const Threshold & threshold)
+{
+    Rule & rule    = mRules[key];
+    rule.threshold = threshold;
+    if (!threshold.IsEmpty() && threshold.maxIntervalMs == 0)
+    {
+        rule.threshold.maxIntervalMs = std::max(kDefaultMaxIntervalMs, threshold.minIntervalMs);
+    }
+    rule.reported  = false;
+    rule.pending   = false;
+    VerifyOrReturn(!threshold.IsEmpty());
+    ChipLogDetail(Zcl, "ReportThrottle: ep=%u cluster=0x%" PRIx32 " attr=0x%" PRIx32 " delta=%" PRId64 "/%.3f interval=%" PRIu32
+                  "..%" PRIu32 " ms",
+                  std::get<0>(key), std::get<1>(key), std::get<2>(key), threshold.absoluteDelta, threshold.relativeDelta,
+                  rule.threshold.minIntervalMs, rule.threshold.maxIntervalMs);
+    StartTimerThreadLocked();
+}
+
+void ReportThrottle::StartTimerThreadLocked()
+{
+    VerifyOrReturn(!mTimerThreadStarted);
+    std::thread(&ReportThrottle::Run, this).detach();
+    mTimerThreadStarted = true;
+}
+
+void ReportThrottle::RemoveEndpoint(EndpointId endpoint)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mRules.lower_bound(Key(endpoint, 0, 0));
+    while (it != mRules.end() && std::get<0>(it->first) == endpoint)
+    {
+        it = mRules.erase(it);
+    }
+}
+
+bool ReportThrottle::IsSignificant(const Threshold & threshold, int64_t reported, int64_t value)
+{
+    uint64_t delta = (value > reported) ? static_cast<uint64_t>(value) - static_cast<uint64_t>(reported)
+                                        : static_cast<uint64_t>(reported) - static_cast<uint64_t>(value);
+    if (threshold.absoluteDelta == 0 && threshold.relativeDelta == 0)
+    {
+        // interval-only rule
+        return delta != 0;
+    }
+    if (threshold.absoluteDelta > 0 && delta >= static_cast<uint64_t>(threshold.absoluteDelta))
+    {
+        return true;
+    }
+    return threshold.relativeDelta > 0 &&
+        static_cast<double>(delta) >= threshold.relativeDelta * std::fabs(static_cast<double>(reported));
+}
+
+bool ReportThrottle::ShouldReport(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, int64_t value)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Key key(endpoint, clusterId, attributeId);
+    auto it = mRules.find(key);
+    if (it == mRules.end())
+    {
+        auto fallback = mDefaults.find(std::make_pair(clusterId, attributeId));
+        VerifyOrReturnValue(fallback != mDefaults.end() && !fallback->second.IsEmpty(), true);
+        ConfigureLocked(key, fallback->second);
+        it = mRules.find(key);
+    }
+    VerifyOrReturnValue(!it->second.threshold.IsEmpty(), true);
+
+    Rule & rule      = it->second;
+    TimePoint now    = std::chrono::steady_clock::now();
+    auto minInterval = std::chrono::milliseconds(rule.threshold.minIntervalMs);
+    bool significant = !rule.reported || IsSignificant(rule.threshold, rule.lastReportedValue, value);
+
+    if (significant && (!rule.reported || now - rule.lastReportTime >= minInterval))
+    {
+        rule.reported          = true;
+        rule.lastReportedValue = value;
+        rule.lastReportTime    = now;
+        rule.pending           = false;
+        return true;
+    }
+
+    mSuppressed++;
+    rule.pending      = (value != rule.lastReportedValue);
+    rule.pendingValue = value;
+    // Every rule has a max interval (see ConfigureLocked), so a pending change always gets a deadline
+    rule.deadline = rule.lastReportTime +
+        (significant ? minInterval : std::chrono::milliseconds(rule.threshold.maxIntervalMs));
+
+    if (rule.pending)
+    {
+        mWakeup.notify_one();
+    }
+    return false;
+}
+
+bool ReportThrottle::NextDeadline(TimePoint & deadline)
+{
+    bool found = false;
+    for (const auto & item : mRules)
+    {
+        if (item.second.pending && item.second.deadline != TimePoint::max() && (!found || item.second.deadline < deadline))
+        {
+            deadline = item.second.deadline;
+            found    = true;
+        }
+    }
+    return found;
+}
+
+void ReportThrottle::Run()
+{
+    std::vector<Key> due;
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true)
+    {
+        TimePoint deadline;
+        if (!NextDeadline(deadline))
+        {
+            mWakeup.wait(lock);
+            continue;
+        }
+        if (mWakeup.wait_until(lock, deadline) == std::cv_status::no_timeout)
+        {
+            // a rule changed, its deadline may be earlier
+            continue;
+        }
+
+        TimePoint now = std::chrono::steady_clock::now();
+        for (auto & item : mRules)
+        {
+            Rule & rule = item.second;
+            if (rule.pending && rule.deadline <= now)
+            {
+                rule.lastReportedValue = rule.pendingValue;
+                rule.lastReportTime    = now;
+                rule.pending           = false;
+                due.push_back(item.first);
+            }
+        }
+
+        lock.unlock();
+        for (const auto & key : due)
+        {
+            ReportQueue::GetInstance().Push(std::get<0>(key), std::get<1>(key), std::get<2>(key));
+        }
+        mDeferredReports += due.size();
+        due.clear();
+        lock.lock();
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+/**
+ * @brief Reportable-change thresholds for noisy numeric attributes.
+ *
+ * An attribute with a threshold is only reported when its value moved far enough away from the value last reported,
+ * and not more often than its minimum interval. Because the distance is measured from the last reported value rather
+ * than the previous sample, a reading jittering around a threshold does not produce a report per sample.
+ * Suppressed values stay stored and readable; a timer thread reports the latest of them once the minimum interval
+ * has passed (significant change) or at the latest after the maximum interval (any change).
+ */
+class ReportThrottle
+{
+public:
+    struct Threshold
+    {
+        int64_t absoluteDelta  = 0; // in attribute units, 0 to disable
+        double relativeDelta   = 0; // fraction of the last reported value, 0 to disable
+        uint32_t minIntervalMs = 0;
+        uint32_t maxIntervalMs = 0; // 0: kDefaultMaxIntervalMs, so a suppressed change is always reported eventually
+
+        bool IsEmpty() const { return absoluteDelta == 0 && relativeDelta == 0 && minIntervalMs == 0 && maxIntervalMs == 0; }
+    };
+
+    // Suppressed changes are stored without bumping the cluster DataVersion, so they must be reported at some point:
+    // data-version-filtered reads would otherwise keep serving the old value
+    static constexpr uint32_t kDefaultMaxIntervalMs = 60000;
+
+    static ReportThrottle & GetInstance() { return sInstance; }
+
+    // an empty threshold turns throttling off for the attribute, default included
+    void Configure(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId,
+                   const Threshold & threshold);
+    // Threshold for an attribute on every endpoint that has none configured. Applied on its first report, so adding
+    // an endpoint does not touch the rules and a threshold set from Java (before or after the add) wins.
+    void ConfigureDefault(chip::ClusterId clusterId, chip::AttributeId attributeId, const Threshold & threshold);
+    void RemoveEndpoint(chip::EndpointId endpoint);
+
+    // Called with the new value of a changed attribute; false if the report is suppressed (or deferred to the timer).
+    // Attributes without a threshold are always reported.
+    bool ShouldReport(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId, int64_t value);
+
+    uint64_t GetSuppressedCount() const { return mSuppressed; }
+    uint64_t GetDeferredReportCount() const { return mDeferredReports; }
+
+private:
+    using Key       = std::tuple<chip::EndpointId, chip::ClusterId, chip::AttributeId>;
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    struct Rule
+    {
+        Threshold threshold;
+        bool reported = false;
+        int64_t lastReportedValue;
+        TimePoint lastReportTime;
+        bool pending = false;
+        int64_t pendingValue;
+        TimePoint deadline;
+    };
+
+    static ReportThrottle sInstance;
+
+    static bool IsSignificant(const Threshold & threshold, int64_t reported, int64_t value);
+
+    void ConfigureLocked(const Key & key, const Threshold & threshold);
+    void StartTimerThreadLocked();
+
+    void Run();
+    bool NextDeadline(TimePoint & deadline);
+
+    std::mutex mLock;
+    std::condition_variable mWakeup;
+    std::map<Key, Rule> mRules;
+    std::map<std::pair<chip::ClusterId, chip::AttributeId>, Threshold> mDefaults;
+    bool mTimerThreadStarted = false;
+
+    std::atomic<uint64_t> mSuppressed{ 0 };
+    std::atomic<uint64_t> mDeferredReports{ 0 };
+};
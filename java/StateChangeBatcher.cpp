@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "StateChangeBatcher.h"
+#include "BridgeApp-JNI.h"
+
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace chip;
+
+StateChangeBatcher StateChangeBatcher::sInstance;
+
+void StateChangeBatcher::Configure(uint32_t flushIntervalMs, size_t maxBatchSize)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    mFlushInterval = std::chrono::milliseconds(flushIntervalMs);
+    mMaxBatchSize  = std::max<size_t>(maxBatchSize, 1);
+    ChipLogProgress(Zcl, "StateChangeBatcher: flush every %u ms or %u changes", static_cast<unsigned>(flushIntervalMs),
+                    static_cast<unsigned>(mMaxBatchSize));
+    mWakeup.notify_one();
+}
+
+void StateChangeBatcher::Add(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, ByteSpan value)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    Key key(endpoint, clusterId, attributeId);
+    auto it = mChangeIndex.find(key);
+    if (it != mChangeIndex.end())
+    {
+        // Latest value wins within a batch
+        mChanges[it->second].value.assign(value.begin(), value.end());
+        return;
+    }
+
+    if (mChanges.empty())
+    {
+        mOldestChange = std::chrono::steady_clock::now();
+    }
+    mChangeIndex.emplace(key, mChanges.size());
+    mChanges.push_back({ key, std::vector<uint8_t>(value.begin(), value.end()) });
+
+    if (!mFlushThreadStarted)
+    {
+        // Lives as long as the process; attaches to the VM once, on its first upcall
+        std::thread(&StateChangeBatcher::Run, this).detach();
+        mFlushThreadStarted = true;
+    }
+    if (mChanges.size() == 1 || mChanges.size() >= mMaxBatchSize)
+    {
+        mWakeup.notify_one();
+    }
+}
+
+void StateChangeBatcher::Run()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true)
+    {
+        mWakeup.wait(lock, [this] { return !mChanges.empty(); });
+        mWakeup.wait_until(lock, mOldestChange + mFlushInterval, [this] { return mChanges.size() >= mMaxBatchSize; });
+
+        Batch batch = TakeBatch();
+        lock.unlock();
+        if (batch.Size() > 0)
+        {
+            BridgeAppJNIMgr().PostDeviceStateChangedBatch(batch);
+        }
+        lock.lock();
+    }
+}
+
+StateChangeBatcher::Batch StateChangeBatcher::TakeBatch()
+{
+    Batch batch;
+    batch.endpoints.reserve(mChanges.size());
+    batch.clusterIds.reserve(mChanges.size());
+    batch.attributeIds.reserve(mChanges.size());
+    batch.offsets.reserve(mChanges.size() + 1);
+
+    for (const auto & change : mChanges)
+    {
+        batch.endpoints.push_back(static_cast<int32_t>(std::get<0>(change.key)));
+        batch.clusterIds.push_back(static_cast<int32_t>(std::get<1>(change.key)));
+        batch.attributeIds.push_back(static_cast<int32_t>(std::get<2>(change.key)));
+        batch.offsets.push_back(static_cast<int32_t>(batch.values.size()));
+        batch.values.insert(batch.values.end(), change.value.begin(), change.value.end());
+    }
+    batch.offsets.push_back(static_cast<int32_t>(batch.values.size()));
+
+    mChanges.clear();
+    mChangeIndex.clear();
+    return batch;
+}
@@ -0,0 +1,86 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief Accumulates device state changes destined for Java and delivers them in batches.
+ *
+ * Changes are collected per (endpoint, cluster, attribute); a later change of the same attribute replaces the
+ * value of an earlier one still waiting. A flush thread hands the batch to Java in a single upcall once the
+ * oldest pending change is older than the flush interval, or as soon as the batch reaches its size threshold.
+ */
+class StateChangeBatcher
+{
+public:
+    // Parallel arrays, value i spans values[offsets[i], offsets[i + 1])
+    struct Batch
+    {
+        std::vector<int32_t> endpoints;
+        std::vector<int32_t> clusterIds;
+        std::vector<int32_t> attributeIds;
+        std::vector<int32_t> offsets;
+        std::vector<uint8_t> values;
+
+        size_t Size() const { return endpoints.size(); }
+    };
+
+    static constexpr uint32_t kDefaultFlushIntervalMs = 50;
+    static constexpr size_t kDefaultMaxBatchSize      = 64;
+
+    static StateChangeBatcher & GetInstance() { return sInstance; }
+
+    // flushIntervalMs 0 delivers every change as soon as the flush thread picks it up
+    void Configure(uint32_t flushIntervalMs, size_t maxBatchSize);
+
+    void Add(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId, chip::ByteSpan value);
+
+private:
+    using Key = std::tuple<chip::EndpointId, chip::ClusterId, chip::AttributeId>;
+
+    struct Change
+    {
+        Key key;
+        std::vector<uint8_t> value;
+    };
+
+    static StateChangeBatcher sInstance;
+
+    void Run();
+    Batch TakeBatch();
+
+    std::mutex mLock;
+    std::condition_variable mWakeup;
+    std::vector<Change> mChanges;        // in arrival order of the first change of each attribute
+    std::map<Key, size_t> mChangeIndex;  // attribute -> position in mChanges
+    std::chrono::steady_clock::time_point mOldestChange;
+    std::chrono::milliseconds mFlushInterval{ kDefaultFlushIntervalMs };
+    size_t mMaxBatchSize     = kDefaultMaxBatchSize;
+    bool mFlushThreadStarted = false;
+};
@@ -0,0 +1,107 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "WorkerPool.h"
+
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <thread>
+
+WorkerPool WorkerPool::sInstance;
+
+void WorkerPool::ParallelFor(size_t count, const std::function<void(size_t)> & fn)
+{
+    VerifyOrReturn(count > 0);
+    if (count == 1)
+    {
+        fn(0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> call(mCallLock);
+
+    auto job = std::make_shared<Job>(fn, count);
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        StartWorkersLocked();
+        mJob = job;
+        mGeneration++;
+    }
+    mWakeup.notify_all();
+
+    Work(*job);
+
+    std::unique_lock<std::mutex> lock(mLock);
+    mFinished.wait(lock, [&job] { return job->done == job->count; });
+    mJob.reset();
+}
+
+size_t WorkerPool::GetWorkerCount()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mWorkers;
+}
+
+void WorkerPool::StartWorkersLocked()
+{
+    VerifyOrReturn(mWorkers == 0);
+
+    // the caller is one more thread working on each job
+    unsigned cores = std::thread::hardware_concurrency();
+    mWorkers       = std::min<size_t>(kMaxWorkers, cores > 1 ? cores - 1 : 1);
+    for (size_t i = 0; i < mWorkers; i++)
+    {
+        std::thread(&WorkerPool::Run, this).detach();
+    }
+}
+
+void WorkerPool::Work(Job & job)
+{
+    size_t processed = 0;
+    for (size_t i = job.next++; i < job.count; i = job.next++)
+    {
+        job.fn(i);
+        processed++;
+    }
+
+    if (processed > 0 && (job.done += processed) == job.count)
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mFinished.notify_all();
+    }
+}
+
+void WorkerPool::Run()
+{
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true)
+    {
+        mWakeup.wait(lock, [this, seen] { return mGeneration != seen; });
+        seen                     = mGeneration;
+        std::shared_ptr<Job> job = mJob;
+
+        lock.unlock();
+        if (job != nullptr)
+        {
+            Work(*job);
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Small pool of worker threads for preparation work that can run in parallel, such as building the endpoints
+ * of a bulk add before they are published on the Matter thread.
+ *
+ * Workers are started on first use and take indices from a shared counter. The calling thread takes part too, so
+ * ParallelFor makes progress even while the workers are busy elsewhere. Calls are serialized; fn must not call
+ * ParallelFor itself.
+ */
+class WorkerPool
+{
+public:
+    static WorkerPool & GetInstance() { return sInstance; }
+
+    // Runs fn(i) for every i in [0, count) and returns once all calls are done
+    void ParallelFor(size_t count, const std::function<void(size_t)> & fn);
+
+    size_t GetWorkerCount();
+
+private:
+    static WorkerPool sInstance;
+
+    static constexpr size_t kMaxWorkers = 4;
+
+    struct Job
+    {
+        Job(const std::function<void(size_t)> & function, size_t total) : fn(function), count(total) {}
+
+        const std::function<void(size_t)> & fn; // only called while indices are left, so while the caller waits
+        const size_t count;
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> done{ 0 };
+    };
+
+    void StartWorkersLocked();
+    void Work(Job & job);
+    void Run();
+
+    std::mutex mCallLock; // one ParallelFor at a time
+    std::mutex mLock;
+    std::condition_variable mWakeup;
+    std::condition_variable mFinished;
+    std::shared_ptr<Job> mJob;
+    uint64_t mGeneration = 0;
+    size_t mWorkers      = 0;
+};
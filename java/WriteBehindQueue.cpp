@@ -0,0 +1,170 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "WriteBehindQueue.h"
+#include "AttributeStore.h"
+#include "BridgeApp-JNI.h"
+#include "ReportQueue.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <cinttypes>
+
+using namespace chip;
+
+WriteBehindQueue WriteBehindQueue::sInstance;
+
+CHIP_ERROR WriteBehindQueue::Commit(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, ByteSpan value)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(!mStopping, CHIP_ERROR_INCORRECT_STATE);
+
+    WriteRecord record;
+    record.hasPrevious = (AttributeStore::GetInstance().GetRawValue(endpoint, clusterId, attributeId, record.previous) == CHIP_NO_ERROR);
+    ReturnErrorOnFailure(AttributeStore::GetInstance().SetRawValue(endpoint, clusterId, attributeId, value));
+    AttributeStore::GetInstance().GetRawValue(endpoint, clusterId, attributeId, record.written);
+    record.sequence = mNextSequence++;
+
+    Key key(endpoint, clusterId, attributeId);
+    mPending.push_back({ key, record.sequence, std::vector<uint8_t>(value.begin(), value.end()) });
+    mWrites[key] = std::move(record);
+
+    if (!mWorker.joinable())
+    {
+        // The worker attaches to the VM once, on its first upcall, and runs until Shutdown
+        mWorker = std::thread(&WriteBehindQueue::Run, this);
+    }
+    mWakeup.notify_one();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteBehindQueue::Reject(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return Revert(Key(endpoint, clusterId, attributeId), nullptr);
+}
+
+void WriteBehindQueue::Forget(EndpointId endpoint)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    for (auto it = mWrites.begin(); it != mWrites.end();)
+    {
+        it = (std::get<0>(it->first) == endpoint) ? mWrites.erase(it) : std::next(it);
+    }
+    mPending.erase(std::remove_if(mPending.begin(), mPending.end(),
+                                  [endpoint](const Notification & pending) { return std::get<0>(pending.key) == endpoint; }),
+                   mPending.end());
+}
+
+void WriteBehindQueue::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mStopping = true;
+        mPending.clear();
+    }
+    mWakeup.notify_one();
+
+    if (mWorker.joinable() && mWorker.get_id() != std::this_thread::get_id())
+    {
+        mWorker.join();
+    }
+}
+
+void WriteBehindQueue::Run()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true)
+    {
+        mWakeup.wait(lock, [this] { return mStopping || !mPending.empty(); });
+        if (mStopping)
+        {
+            return;
+        }
+
+        Notification notification = std::move(mPending.front());
+        mPending.pop_front();
+
+        lock.unlock();
+        Deliver(notification);
+        lock.lock();
+    }
+}
+
+void WriteBehindQueue::Deliver(const Notification & notification)
+{
+    EndpointId endpoint     = std::get<0>(notification.key);
+    ClusterId clusterId     = std::get<1>(notification.key);
+    AttributeId attributeId = std::get<2>(notification.key);
+    // The JNI layer only reads the value, the cast merely matches its signature
+    uint8_t * value = const_cast<uint8_t *>(notification.value.data());
+
+    if (!BridgeAppJNIMgr().HandleClusterAttributeWrite(endpoint, static_cast<int>(clusterId), static_cast<int>(attributeId),
+                                                       value, notification.value.size()))
+    {
+        ChipLogProgress(Zcl, "WriteBehindQueue: Java rejected write of ep=%d, cluster=0x%" PRIx32 ", attr=0x%" PRIx32, endpoint,
+                        clusterId, attributeId);
+        std::lock_guard<std::mutex> lock(mLock);
+        Revert(notification.key, &notification.sequence);
+        return;
+    }
+
+    BridgeAppJNIMgr().PostDeviceStateChanged(endpoint, static_cast<int>(clusterId), static_cast<int>(attributeId), value,
+                                             notification.value.size());
+}
+
+CHIP_ERROR WriteBehindQueue::Revert(const Key & key, const uint64_t * sequence)
+{
+    auto it = mWrites.find(key);
+    VerifyOrReturnError(it != mWrites.end(), CHIP_ERROR_NOT_FOUND);
+    // A newer write of the same attribute, possibly of the same bytes, already replaced the rejected one
+    VerifyOrReturnError(sequence == nullptr || *sequence == it->second.sequence, CHIP_ERROR_INCORRECT_STATE);
+
+    EndpointId endpoint     = std::get<0>(key);
+    ClusterId clusterId     = std::get<1>(key);
+    AttributeId attributeId = std::get<2>(key);
+
+    // Java set the attribute since (updateClusterAttribute, updateInt, ...): its value is newer than the one restored
+    std::vector<uint8_t> current;
+    if (AttributeStore::GetInstance().GetRawValue(endpoint, clusterId, attributeId, current) == CHIP_NO_ERROR &&
+        current != it->second.written)
+    {
+        mWrites.erase(it);
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    if (it->second.hasPrevious)
+    {
+        AttributeStore::GetInstance().SetRawValue(endpoint, clusterId, attributeId,
+                                                  ByteSpan(it->second.previous.data(), it->second.previous.size()));
+    }
+    else
+    {
+        // Nothing to restore: let the next read fetch the value from Java again
+        AttributeStore::GetInstance().Invalidate(endpoint, clusterId, attributeId);
+    }
+    mWrites.erase(it);
+
+    // Corrective report so subscribers see the restored value
+    ReportQueue::GetInstance().Push(endpoint, clusterId, attributeId);
+    return CHIP_NO_ERROR;
+}
@@ -0,0 +1,96 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief Write-behind delivery of controller writes to Java.
+ *
+ * For attributes registered with AttributeStore::kFlag_WriteBehind the write callback commits the value to the
+ * native attribute store and returns right away; the write is then handed to Java (onClusterAttributeWrite followed
+ * by postDeviceStateChanged) on a dedicated worker thread, so the Matter thread never waits on Java.
+ *
+ * Java can refuse a write afterwards, either by returning false from onClusterAttributeWrite or by calling
+ * Reject. The attribute is then restored to the value it had before the write and a report is scheduled so
+ * subscribers see the correction, unless Java pushed a newer value in the meantime.
+ */
+class WriteBehindQueue
+{
+public:
+    static WriteBehindQueue & GetInstance() { return sInstance; }
+
+    // Matter thread: stores the value natively and queues its delivery to Java
+    CHIP_ERROR Commit(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId, chip::ByteSpan value);
+
+    // any thread: reverts the latest write-behind value of an attribute
+    CHIP_ERROR Reject(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId);
+
+    // drops the revert state and undelivered writes of a removed endpoint
+    void Forget(chip::EndpointId endpoint);
+
+    // stops and joins the worker thread; writes not delivered yet are dropped
+    void Shutdown();
+
+    ~WriteBehindQueue() { Shutdown(); }
+
+private:
+    using Key = std::tuple<chip::EndpointId, chip::ClusterId, chip::AttributeId>;
+
+    struct Notification
+    {
+        Key key;
+        uint64_t sequence;
+        std::vector<uint8_t> value;
+    };
+
+    // what a rejection of the latest write of an attribute restores
+    struct WriteRecord
+    {
+        uint64_t sequence;            // tells this write from a newer one of the same bytes
+        std::vector<uint8_t> written; // as stored; once the attribute holds something else, Java superseded the write
+        std::vector<uint8_t> previous;
+        bool hasPrevious;
+    };
+
+    static WriteBehindQueue sInstance;
+
+    void Run();
+    void Deliver(const Notification & notification);
+    // reverts only while the write with `sequence` (if given) is still the latest write of the attribute
+    CHIP_ERROR Revert(const Key & key, const uint64_t * sequence);
+
+    std::mutex mLock;
+    std::condition_variable mWakeup;
+    std::deque<Notification> mPending;
+    std::map<Key, WriteRecord> mWrites;
+    uint64_t mNextSequence = 0;
+    std::thread mWorker;
+    bool mStopping = false;
+};
@@ -18,7 +18,10 @@
 package com.matter.bridge.app;
 
 import android.util.Log;
+import dalvik.annotation.optimization.FastNative;
 import com.matter.bridge.app.ClusterAttribute;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import com.matter.bridge.app.DACProvider;
 
 public class BridgeApp {
@@ -56,6 +59,28 @@ public class BridgeApp {
     }
   }
 
+  private void postDeviceStateChangedBatch(int[] endpoints, int[] clusterIds, int[] attributeIds, byte[] values, int[] offsets) {
+    Log.d(TAG, "postDeviceStateChangedBatch: count=" + endpoints.length);
+    if (mCallback != null) {
+      mCallback.onDeviceStateChangedBatch(endpoints, clusterIds, attributeIds, values, offsets);
+    }
+  }
+
+  private void postBridgedDevicesAdded(int requestId, int[] endpoints, long elapsedMicros) {
+    Log.d(TAG, "postBridgedDevicesAdded: request=" + requestId + ", count=" + endpoints.length + ", elapsedUs=" + elapsedMicros);
+    if (mCallback != null) {
+      mCallback.onBridgedDevicesAdded(requestId, endpoints, elapsedMicros);
+    }
+  }
+
+  private void postBridgedDevicesRestored(int[] endpoints, int[] parentEndpointIds, String[] names, int[][] deviceTypeIds,
+      int[][] clusterIds, long elapsedMicros) {
+    Log.d(TAG, "postBridgedDevicesRestored: count=" + endpoints.length + ", elapsedUs=" + elapsedMicros);
+    if (mCallback != null) {
+      mCallback.onBridgedDevicesRestored(endpoints, parentEndpointIds, names, deviceTypeIds, clusterIds, elapsedMicros);
+    }
+  }
+
   private byte[] onClusterAttributeReadRequest(int endpoint, int clusterId, int attributeId, int maxReadLength) {
     Log.d(TAG, "onClusterAttributeReadRequest: endpoint=" + endpoint + ", cluster=0x" + 
           Integer.toHexString(clusterId) + ", attr=0x" + Integer.toHexString(attributeId));
@@ -65,6 +90,24 @@ public class BridgeApp {
     return null;
   }
 
+  // Direct buffer read protocol, see BridgeAppCallback.onClusterAttributeRead(int, int, int, ByteBuffer)
+  private int onClusterAttributeReadIntoRequest(int endpoint, int clusterId, int attributeId, ByteBuffer buffer, int maxReadLength) {
+    if (mCallback == null) {
+      return BridgeAppCallback.READ_UNAVAILABLE;
+    }
+    buffer.clear().limit(maxReadLength);
+    buffer.order(ByteOrder.LITTLE_ENDIAN);
+    return mCallback.onClusterAttributeRead(endpoint, clusterId, attributeId, buffer);
+  }
+
+  private byte[] onEndpointAttributesRead(int endpoint, int[] clusterIds, int[] attributeIds) {
+    Log.d(TAG, "onEndpointAttributesRead: endpoint=" + endpoint + ", count=" + clusterIds.length);
+    if (mCallback != null) {
+      return mCallback.onEndpointAttributesRead(endpoint, clusterIds, attributeIds);
+    }
+    return null;
+  }
+
   private boolean onClusterAttributeWriteRequest(int endpoint, int clusterId, int attributeId, byte[] value) {
     Log.d(TAG, "onClusterAttributeWriteRequest: endpoint=" + endpoint + ", cluster=0x" + 
           Integer.toHexString(clusterId) + ", attr=0x" + Integer.toHexString(attributeId) + 
@@ -101,15 +144,204 @@ public class BridgeApp {
   public native String getCommissioningQRCode();
 
   // Device Management API
+  /**
+   * Reserves count contiguous endpoint IDs, e.g. for the children of a composed device. Automatic endpoint
+   * assignment skips them; add the children with the reserved IDs as endpoint. Returns the first ID, or -1.
+   */
+  public native int reserveEndpointRange(int count);
+
+  // Frees the IDs of a reserved range that were not used by an added device
+  public native void releaseEndpointRange(int first, int count);
+
   public native boolean addBridgedDevice(int endpoint, int parentEndpointId, String name, int[] clusterIds, ClusterAttribute[] attributes, int[] deviceTypeIds);
+
+  /**
+   * Same as addBridgedDevice(int, int, String, int[], ClusterAttribute[], int[]) with the attributes packed as
+   * consecutive (clusterId, attributeId, type, size, mask) tuples, which native code reads without reflection.
+   * Packed attributes have no flags and no default value.
+   */
+  public native boolean addBridgedDevice(int endpoint, int parentEndpointId, String name, int[] clusterIds, int[] packedAttributes, int[] deviceTypeIds);
+
+  /**
+   * Registers a device definition and returns its template ID, or -1. Identical definitions share one template
+   * (and one native endpoint definition), so registering the same schema again returns the same ID.
+   */
+  public native int registerDeviceTemplate(int[] clusterIds, ClusterAttribute[] attributes, int[] deviceTypeIds);
+
+  // Same as registerDeviceTemplate with packed attributes, see addBridgedDevice(int, int, String, int[], int[], int[])
+  public native int registerDeviceTemplate(int[] clusterIds, int[] packedAttributes, int[] deviceTypeIds);
+
+  // Same as addBridgedDevice with the definition registered under templateId
+  public native boolean addBridgedDeviceFromTemplate(int templateId, int endpoint, int parentEndpointId, String name);
+
+  /**
+   * Adds many devices at once, e.g. at startup: all specs are parsed in one native call and all endpoints are
+   * registered by a single task on the Matter thread. Returns a request ID, or -1 if nothing was queued; the result
+   * is delivered with it to BridgeAppCallback.onBridgedDevicesAdded.
+   */
+  public native int addBridgedDevices(DeviceSpec[] specs);
+
+  /**
+   * Persists the bridged device registry to a binary snapshot at path, rewritten in the background after each
+   * topology change. Must be called before postServerInit: if the file holds a snapshot, its devices are re-created
+   * natively at postServerInit and reported to BridgeAppCallback.onBridgedDevicesRestored, and true is returned so
+   * the caller can skip creating them again.
+   */
+  public native boolean setRegistrySnapshotPath(String path);
+
+  /**
+   * Writes the registry snapshot now instead of waiting for the background writer, e.g. when the app is stopped. Not
+   * for the Matter thread. Only a snapshot written this way, with no change after it, restores cluster DataVersions;
+   * after a crash the restored devices start from new ones.
+   */
+  public native boolean saveRegistrySnapshot();
   
   // Update attribute with Long value (for numeric types)
   public native boolean updateClusterAttribute(int endpoint, int clusterId, int attributeId, long value);
   
-  // TODO: Update attribute with byte array value (for String and complex types)
-  // Currently commented out due to JNI method signature conflict
+  // Update attribute with byte array value (for String and complex types)
   public native boolean updateClusterAttribute(int endpoint, int clusterId, int attributeId, byte[] value);
 
+  /**
+   * Applies many attribute updates in a single call, e.g. the result of a hub poll. Entry i updates
+   * (endpoints[i], clusterIds[i], attributeIds[i]) with packedValues[offsets[i]] up to offsets[i + 1] (exclusive),
+   * encoded as for updateClusterAttribute(int, int, int, byte[]); offsets has one more element than endpoints.
+   * Returns the entries that were stored as BitSet.valueOf(result), or null (nothing applied) if the arrays are
+   * inconsistent or an entry names an endpoint or attribute that does not exist.
+   */
+  public native long[] updateClusterAttributes(int[] endpoints, int[] clusterIds, int[] attributeIds, byte[] packedValues, int[] offsets);
+
+  /**
+   * Typed updates for high-rate values (OnOff, measured values, battery level...). Integers are stored
+   * little-endian truncated to the attribute size. Unlike updateClusterAttribute these take primitives only,
+   * so on API 26+ they are called with a reduced JNI transition.
+   */
+  @FastNative
+  public static native boolean updateBool(int endpoint, int clusterId, int attributeId, boolean value);
+
+  @FastNative
+  public static native boolean updateInt(int endpoint, int clusterId, int attributeId, long value);
+
+  /**
+   * Returns a direct buffer shared with the native attribute store of an endpoint, or null if the endpoint is
+   * unknown. Values are little-endian at the offsets given by getAttributeOffset (strings start with their ZCL
+   * length prefix); after writing a value in place, publish it with markAttributeDirty. The int in front of each
+   * value is its write sequence: make it odd before writing and even again after, one writer per buffer at a time.
+   * Values set natively (controller writes, update* calls) are not written into the buffer. Attaching a new buffer
+   * (or removing the endpoint) detaches the previous one, and offsets may change when the endpoint is added again.
+   */
+  public ByteBuffer getAttributeBuffer(int endpoint) {
+    int size = getAttributeBufferSize(endpoint);
+    if (size <= 0) {
+      return null;
+    }
+    ByteBuffer buffer = ByteBuffer.allocateDirect(size).order(ByteOrder.LITTLE_ENDIAN);
+    return attachAttributeBuffer(endpoint, buffer) ? buffer : null;
+  }
+
+  public native int getAttributeBufferSize(int endpoint);
+
+  private native boolean attachAttributeBuffer(int endpoint, ByteBuffer buffer);
+
+  // Offset of an attribute in the shared buffer, or -1 if the attribute is not stored natively
+  public native int getAttributeOffset(int endpoint, int clusterId, int attributeId);
+
+  // Results of markAttributeDirty
+  public static final int MARK_DIRTY_OK = 0;
+  // The buffer is no longer attached: attach a new one with getAttributeBuffer, re-fetch the offsets and write again
+  public static final int MARK_DIRTY_DETACHED = 1;
+  // A write to the slot was still in progress; calling markAttributeDirty again publishes it
+  public static final int MARK_DIRTY_RETRY = 2;
+  // The attribute is not stored natively or cannot be written
+  public static final int MARK_DIRTY_FAILED = 3;
+
+  // Publishes a value written in place and reports it to subscribers, returns one of the MARK_DIRTY_* results
+  public native int markAttributeDirty(int endpoint, ByteBuffer buffer, int clusterId, int attributeId);
+
+  /**
+   * Controls how device state changes are batched before reaching BridgeAppCallback.onDeviceStateChangedBatch:
+   * a batch is delivered once its oldest change is flushIntervalMs old, or once maxBatchSize attributes changed.
+   */
+  public native void setStateChangeBatching(int flushIntervalMs, int maxBatchSize);
+
+  /**
+   * Sets the reportable-change threshold of a numeric attribute. A new value is reported once it differs from the
+   * last reported one by absoluteDelta (attribute units) or relativeDelta (fraction of the last reported value),
+   * but not more often than every minIntervalMs; smaller changes are stored and reported after maxIntervalMs
+   * (0 means 60 s, or minIntervalMs if longer). Temperature and humidity MeasuredValue default to a deadband of 10
+   * with a 30 s max interval. Passing all zeros turns throttling off for the attribute, including its default.
+   */
+  public native void setReportingThreshold(int endpoint, int clusterId, int attributeId, long absoluteDelta, double relativeDelta, int minIntervalMs, int maxIntervalMs);
+
+  /**
+   * Counters of the reportable-change thresholds: { updates not reported immediately, deferred reports sent by
+   * the min/max interval timer }.
+   */
+  public native long[] getReportThrottleStats();
+
+  /**
+   * Native endpoint metadata (cluster and attribute definitions, device types, data versions): { bytes in use, peak
+   * bytes in use, allocated blocks, endpoint templates }. Templates not registered with registerDeviceTemplate are
+   * freed with their last device, and each device's data versions are freed when it is removed.
+   */
+  public native long[] getEndpointMetadataStats();
+
+  /**
+   * Time spent on the Matter thread adding bridged devices, whose endpoints are prepared beforehand off that thread:
+   * { devices published, devices that failed, total microseconds, longest single device in microseconds }.
+   */
+  public native long[] getPublishStats();
+
+  /**
+   * Rejects the latest write-behind write (see ClusterAttribute.FLAG_WRITE_BEHIND) of an attribute after it was
+   * acknowledged: the previous value is restored and reported. Returns false if there is nothing to revert,
+   * including when a value pushed from Java since the write replaced it.
+   */
+  public native boolean rejectAttributeWrite(int endpoint, int clusterId, int attributeId);
+
+  /**
+   * Counters of the native negative read cache: { reads answered as unsupported without calling into Java, reads
+   * of attributes without a native value that went to Java }. Only READ_UNHANDLED answers of the direct buffer read
+   * are cached, and an attribute leaves the cache once its value is updated.
+   */
+  public native long[] getNegativeCacheStats();
+
+  /**
+   * Native threads attached to / detached from the VM for upcalls: { attaches, detaches }. Each thread attaches
+   * once and stays attached until it exits, so both counters should stay flat under steady load.
+   */
+  public native long[] getJniAttachStats();
+
+  /**
+   * Counters of the native report queue: { attribute paths enqueued for reporting, duplicates merged before
+   * reporting, paths dropped because the queue was full }.
+   */
+  public native long[] getReportQueueStats();
+
+  /** Number of attribute updates that were not reported because the value had not changed. */
+  public native long getUnchangedUpdateCount();
+
+  /**
+   * Latency of commands and attribute writes on a cluster, from receipt to the report confirming them, in
+   * microseconds: { count, p50, p99, max } for each of the segments dispatch (receipt to upcall), upcall,
+   * until-report (receipt to report queued), report-queue (queued to flushed) and total. Null if nothing was traced.
+   */
+  public native long[] getLatencyStats(int clusterId);
+
+  // Latency histograms of all clusters as text, one line per cluster and segment
+  public native String dumpLatencyStats();
+
+  // Tracing is off by default; reset drops open traces and recorded histograms
+  public native void setLatencyTracing(boolean enabled, boolean reset);
+
+  /**
+   * Issues reads of one attribute through both read protocols, paced at readsPerSecond, and returns the average
+   * time spent in the upcall per read in nanoseconds: { byte[] protocol, direct buffer protocol }.
+   * Blocks for about 2 * reads / readsPerSecond seconds, call it from a background thread.
+   * Only built with bridge_app_read_benchmark = true (see BUILD.gn); throws UnsatisfiedLinkError otherwise.
+   */
+  public native long[] benchmarkReadProtocols(int endpoint, int clusterId, int attributeId, int reads, int readsPerSecond);
+
   static {
     System.loadLibrary("BridgeApp");
   }
@@ -16,7 +16,25 @@
  */
 package com.matter.bridge.app;
 
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
 public interface BridgeAppCallback {
+  /** Length marker for attributes not handled in a batched read. */
+  int UNHANDLED_ATTRIBUTE = 0xFFFF;
+  /** Largest attribute value the Matter stack reads in one go. */
+  int MAX_ATTRIBUTE_LENGTH = 0xFFFE;
+  /**
+   * Direct buffer read result: the attribute is not supported. The native layer answers further reads as unsupported
+   * without calling into Java, until the attribute value is updated.
+   */
+  int READ_UNHANDLED = -1;
+  /** Direct buffer read result: the value is larger than the buffer limit. */
+  int READ_TOO_LARGE = -2;
+  /** Direct buffer read result: no value right now (e.g. the device is not known yet), ask again next time. */
+  int READ_UNAVAILABLE = -3;
+
   void onClusterInit(BridgeApp app, long clusterId, int endpoint);
 
   void onEvent(long event);
@@ -30,6 +48,43 @@ public interface BridgeAppCallback {
    */
   void onDeviceStateChanged(int endpoint, int clusterId, int attributeId, byte[] value);
 
+  /**
+   * Called with the device state changes accumulated since the previous batch, at most one per attribute (the
+   * latest value). The default implementation calls onDeviceStateChanged for each of them.
+   * @param endpoints The endpoint ID of each change
+   * @param clusterIds The cluster ID of each change
+   * @param attributeIds The attribute ID of each change
+   * @param values The raw values of all changes, back to back
+   * @param offsets Change i spans values[offsets[i]] to values[offsets[i + 1]] (exclusive)
+   */
+  default void onDeviceStateChangedBatch(int[] endpoints, int[] clusterIds, int[] attributeIds, byte[] values, int[] offsets) {
+    for (int i = 0; i < endpoints.length; i++) {
+      onDeviceStateChanged(endpoints[i], clusterIds[i], attributeIds[i], Arrays.copyOfRange(values, offsets[i], offsets[i + 1]));
+    }
+  }
+
+  /**
+   * Called once all devices of a BridgeApp.addBridgedDevices call were registered (or failed).
+   * @param requestId The ID returned by addBridgedDevices
+   * @param endpoints The endpoint ID of each device, in spec order, or -1 if the device was not added
+   * @param elapsedMicros Time from the addBridgedDevices call until all endpoints were online
+   */
+  default void onBridgedDevicesAdded(int requestId, int[] endpoints, long elapsedMicros) {}
+
+  /**
+   * Called after postServerInit when devices were re-created from the registry snapshot (see
+   * BridgeApp.setRegistrySnapshotPath). Their endpoints are already online; only the Kotlin handlers need to be
+   * attached again. All arrays are indexed by device.
+   * @param endpoints The endpoint ID of each device
+   * @param parentEndpointIds The parent endpoint ID of each device
+   * @param names The name of each device
+   * @param deviceTypeIds The device types of each device
+   * @param clusterIds The server clusters of each device
+   * @param elapsedMicros Time taken to restore the snapshot
+   */
+  default void onBridgedDevicesRestored(int[] endpoints, int[] parentEndpointIds, String[] names, int[][] deviceTypeIds,
+      int[][] clusterIds, long elapsedMicros) {}
+
   /**
    * Called when Matter stack needs to read an attribute value.
    * @param endpoint The endpoint ID
@@ -41,11 +96,61 @@ public interface BridgeAppCallback {
   byte[] onClusterAttributeRead(int endpoint, int clusterId, int attributeId, int maxReadLength);
 
   /**
-   * Called when Matter stack receives an attribute write request.
+   * Allocation-free variant of onClusterAttributeRead: the value is written into a direct buffer reused by the
+   * native layer for every read on the calling thread. The default implementation copies the result of
+   * onClusterAttributeRead; as a null from there does not tell why, it is passed on as READ_UNAVAILABLE.
+   * @param endpoint The endpoint ID
+   * @param clusterId The cluster ID
+   * @param attributeId The attribute ID
+   * @param out Little-endian buffer positioned at 0, its limit is the maximum number of bytes that can be returned
+   * @return Number of bytes written to out, READ_UNHANDLED if the attribute is not supported, READ_UNAVAILABLE if
+   *     there is no value right now, or READ_TOO_LARGE if the value does not fit; the read then fails instead of
+   *     reporting the attribute as unsupported
+   */
+  default int onClusterAttributeRead(int endpoint, int clusterId, int attributeId, ByteBuffer out) {
+    byte[] value = onClusterAttributeRead(endpoint, clusterId, attributeId, out.limit());
+    if (value == null) {
+      return READ_UNAVAILABLE;
+    }
+    if (value.length > out.remaining()) {
+      return READ_TOO_LARGE;
+    }
+    out.put(value);
+    return value.length;
+  }
+
+  /**
+   * Called once per endpoint when a wildcard read or subscription priming needs several attribute values.
+   * The default implementation answers each attribute through onClusterAttributeRead.
+   * @param endpoint The endpoint ID
+   * @param clusterIds The cluster ID of each requested attribute
+   * @param attributeIds The attribute ID of each requested attribute
+   * @return For each requested attribute, in order, a little-endian 16-bit length followed by the value bytes;
+   *         a length of 0xFFFF marks an attribute that is not handled. Null if nothing is handled.
+   */
+  default byte[] onEndpointAttributesRead(int endpoint, int[] clusterIds, int[] attributeIds) {
+    ByteArrayOutputStream packed = new ByteArrayOutputStream();
+    for (int i = 0; i < clusterIds.length; i++) {
+      byte[] value = onClusterAttributeRead(endpoint, clusterIds[i], attributeIds[i], MAX_ATTRIBUTE_LENGTH);
+      int length = (value != null && value.length < UNHANDLED_ATTRIBUTE) ? value.length : UNHANDLED_ATTRIBUTE;
+      packed.write(length & 0xFF);
+      packed.write((length >> 8) & 0xFF);
+      if (length != UNHANDLED_ATTRIBUTE) {
+        packed.write(value, 0, length);
+      }
+    }
+    return packed.toByteArray();
+  }
+
+  /**
+   * Called when Matter stack receives an attribute write request. For attributes registered with
+   * ClusterAttribute.FLAG_WRITE_BEHIND the write has already been acknowledged and this runs on a background
+   * thread; returning false reverts the value.
    * @param endpoint The endpoint ID
    * @param clusterId The cluster ID
    * @param attributeId The attribute ID
-   * @param value The raw attribute value bytes
+   * @param value The raw attribute value bytes, exactly as large as the encoded value: the attribute size for
+   *     fixed-size types, the ZCL length prefix plus the data for strings
    * @return true if write was handled successfully, false otherwise
    */
   boolean onClusterAttributeWrite(int endpoint, int clusterId, int attributeId, byte[] value);
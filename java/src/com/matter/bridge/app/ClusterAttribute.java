@@ -1,17 +1,45 @@
 package com.matter.bridge.app;
 
 public class ClusterAttribute {
+    /** Attribute value is always read from Java and never cached by the native attribute store. */
+    public static final int FLAG_JAVA_OWNED = 0x01;
+    /** Attribute value never changes after registration and is answered natively from defaultValue. */
+    public static final int FLAG_CONSTANT = 0x02;
+    /**
+     * Controller writes are acknowledged from the native value and delivered to onClusterAttributeWrite later,
+     * on a background thread. Returning false there (or calling BridgeApp.rejectAttributeWrite) reverts the value.
+     */
+    public static final int FLAG_WRITE_BEHIND = 0x04;
+
     public int clusterId;
     public int attributeId;
     public int type;
     public int size;
     public int mask;
+    public int flags;
+    /** Initial value, little-endian for integers and without length prefix for strings; may be null. */
+    public byte[] defaultValue;
 
     public ClusterAttribute(int clusterId, int attributeId, int type, int size, int mask) {
+        this(clusterId, attributeId, type, size, mask, 0, null);
+    }
+
+    public ClusterAttribute(int clusterId, int attributeId, int type, int size, int mask, int flags) {
+        this(clusterId, attributeId, type, size, mask, flags, null);
+    }
+
+    public ClusterAttribute(int clusterId, int attributeId, int type, int size, int mask, int flags, byte[] defaultValue) {
         this.clusterId = clusterId;
         this.attributeId = attributeId;
         this.type = type;
         this.size = size;
         this.mask = mask;
+        this.flags = flags;
+        this.defaultValue = defaultValue;
+    }
+
+    /** Creates a read-only attribute whose value is fixed at registration, e.g. ClusterRevision or FeatureMap. */
+    public static ClusterAttribute constant(int clusterId, int attributeId, int type, int size, int mask, byte[] value) {
+        return new ClusterAttribute(clusterId, attributeId, type, size, mask, FLAG_CONSTANT, value);
     }
 }
@@ -0,0 +1,29 @@
+package com.matter.bridge.app;
+
+/** One device of a BridgeApp.addBridgedDevices call. */
+public class DeviceSpec {
+    /** Requested endpoint ID, or 0xFFFF to have one assigned. */
+    public int endpoint;
+    public int parentEndpointId;
+    public String name;
+    /** Template from BridgeApp.registerDeviceTemplate, or 0 to use the definition below. */
+    public int templateId;
+    public int[] clusterIds;
+    public ClusterAttribute[] attributes;
+    public int[] deviceTypeIds;
+
+    public DeviceSpec(int endpoint, int parentEndpointId, String name, int[] clusterIds, ClusterAttribute[] attributes, int[] deviceTypeIds) {
+        this.endpoint = endpoint;
+        this.parentEndpointId = parentEndpointId;
+        this.name = name;
+        this.clusterIds = clusterIds;
+        this.attributes = attributes;
+        this.deviceTypeIds = deviceTypeIds;
+    }
+
+    public static DeviceSpec fromTemplate(int templateId, int endpoint, int parentEndpointId, String name) {
+        DeviceSpec spec = new DeviceSpec(endpoint, parentEndpointId, name, null, null, null);
+        spec.templateId = templateId;
+        return spec;
+    }
+}